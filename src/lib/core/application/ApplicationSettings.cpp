@@ -10,6 +10,8 @@
 #include <QObject>
 #include <QString>
 
+#include <algorithm>
+
 #include <score_git_info.hpp>
 namespace score
 {
@@ -49,6 +51,14 @@ void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
       "0");
   parser.addOption(waitLoadOpt);
 
+  QCommandLineOption undoMemoryOpt(
+      "undo-memory",
+      QCoreApplication::translate(
+          "main", "Memory in MiB for the undo history, past which it is stored on the disk."),
+      "MiB",
+      "128");
+  parser.addOption(undoMemoryOpt);
+
   if (cargs.contains("--help") || cargs.contains("--version"))
   {
     QCoreApplication app(argc, argv);
@@ -73,6 +83,9 @@ void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
   if (parser.isSet(waitLoadOpt))
     waitAfterLoad = parser.value(waitLoadOpt).toInt();
 
+  if (parser.isSet(undoMemoryOpt))
+    undoMemory = std::max(0, parser.value(undoMemoryOpt).toInt());
+
   if (!args.empty() && QFile::exists(args[0]))
   {
     loadList.push_back(args[0]);
@@ -36,6 +36,9 @@ struct SCORE_LIB_BASE_EXPORT ApplicationSettings
   //! Seconds to wait before playing
   int waitAfterLoad = 0;
 
+  //! Memory in MiB for the compressed undo history, past which it goes to the disk
+  int undoMemory = 128;
+
   void parse(QStringList args, int& argc, char** argv);
 };
 
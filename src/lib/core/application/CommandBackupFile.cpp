@@ -3,13 +3,79 @@
 #include "CommandBackupFile.hpp"
 
 #include <score/command/Command.hpp>
+#include <score/plugins/StringFactoryKeySerialization.hpp>
 #include <score/serialization/DataStreamVisitor.hpp>
 #include <score/tools/Bind.hpp>
 
 #include <core/command/CommandStack.hpp>
 
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QSaveFile>
+#include <QTemporaryFile>
+
 namespace score
 {
+namespace
+{
+// "SCJ1"
+static constexpr quint32 journal_magic = 0x53434A31;
+
+// After this many records the journal is rewritten as a single snapshot
+static constexpr int compaction_threshold = 500;
+
+enum RecordType : quint8
+{
+  Snapshot = 1,
+  Push = 2,
+  Undo = 3,
+  Redo = 4
+};
+
+QByteArray encodeRecord(quint8 type, const QByteArray& payload)
+{
+  QByteArray rec;
+  rec.reserve(payload.size() + 16);
+  QDataStream s{&rec, QIODevice::WriteOnly};
+  s << type << quint32(payload.size()) << qChecksum(payload.constData(), payload.size());
+  s.writeRawData(payload.constData(), payload.size());
+  return rec;
+}
+
+QByteArray encodeSnapshot(const QStack<CommandData>& undo, const QStack<CommandData>& redo)
+{
+  QByteArray arr;
+  DataStream::Serializer ser{&arr};
+  ser.readFrom(std::vector<CommandData>(undo.begin(), undo.end()));
+  ser.readFrom(std::vector<CommandData>(redo.begin(), redo.end()));
+  ser.insertDelimiter();
+  return arr;
+}
+
+bool restoreLegacy(
+    const QByteArray& data,
+    std::vector<CommandData>& undoStack,
+    std::vector<CommandData>& redoStack)
+{
+  try
+  {
+    DataStream::Deserializer writer{data};
+    writer.writeTo(undoStack);
+    writer.writeTo(redoStack);
+    writer.checkDelimiter();
+    return true;
+  }
+  catch (const std::exception& e)
+  {
+    qDebug() << "Could not restore commands: " << e.what();
+    undoStack.clear();
+    redoStack.clear();
+    return false;
+  }
+}
+}
+
 CommandStackBackup::CommandStackBackup(const CommandStack& stack)
 {
   // Load initial state
@@ -26,99 +92,258 @@ CommandStackBackup::CommandStackBackup(const CommandStack& stack)
 CommandBackupFile::CommandBackupFile(const score::CommandStack& stack, QObject* parent)
     : QObject{parent}, m_stack{stack}, m_backup{m_stack}
 {
-  m_file.open();
+  // The temporary file is only used to reserve a unique file name:
+  // the journal is then written by the background thread.
+  {
+    QTemporaryFile file;
+    file.setAutoRemove(false);
+    file.open();
+    m_fileName = file.fileName();
+  }
+  m_journal.setFileName(m_fileName);
+
+#if !defined(__EMSCRIPTEN__)
+  m_thread = std::thread{[this] { writeThread(); }};
+#endif
 
   // Set-up signals
   con(m_stack, &CommandStack::sig_push, this, &CommandBackupFile::on_push);
   con(m_stack, &CommandStack::sig_undo, this, &CommandBackupFile::on_undo);
   con(m_stack, &CommandStack::sig_redo, this, &CommandBackupFile::on_redo);
-  con(m_stack, &CommandStack::sig_indexChanged, this, &CommandBackupFile::on_indexChanged);
+  con(m_stack, &CommandStack::stackChanged, this, &CommandBackupFile::on_stackChanged);
 
   // Initial backup so that the file is always in a loadable state.
-  commit();
+  compact();
+}
+
+CommandBackupFile::~CommandBackupFile()
+{
+  if (m_thread.joinable())
+  {
+    {
+      std::lock_guard lck{m_mutex};
+      m_running = false;
+    }
+    m_cv.notify_all();
+    m_thread.join();
+  }
 }
 
 QString CommandBackupFile::fileName() const
 {
-  return m_file.fileName();
+  return m_fileName;
 }
 
 void CommandBackupFile::on_push()
 {
-  /*
   // A new command is added to m_undoable
-  // m_redoable should be cleared
-  auto cmd = m_stack.m_undoable.last();
-  m_backup.savedUndo.push(CommandData{*cmd});
-
+  // m_redoable has been cleared
+  CommandData cmd{*m_stack.undoable().top()};
+  m_backup.savedUndo.push(cmd);
   m_backup.savedRedo.clear();
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  append(Push, DataStream::Serializer::marshall(cmd));
 }
 
 void CommandBackupFile::on_undo()
 {
-  /*
   // Pop from undoable to redoable
-  m_backup.savedRedo.push(m_savedUndo.pop());
+  if (m_backup.savedUndo.empty())
+    return;
+  m_backup.savedRedo.push(m_backup.savedUndo.pop());
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  append(Undo, {});
 }
 
 void CommandBackupFile::on_redo()
 {
-  /*
   // Pop from redoable to undoable
-  m_backup.savedUndo.push(m_savedRedo.pop());
+  if (m_backup.savedRedo.empty())
+    return;
+  m_backup.savedUndo.push(m_backup.savedRedo.pop());
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  append(Redo, {});
 }
 
-void CommandBackupFile::on_indexChanged()
+void CommandBackupFile::on_stackChanged()
 {
-  /*
-  // Pop a lot
-  auto index = m_stack.currentIndex();
-  if(index > m_previousIndex)
+  // The stack can also be modified without any of the push / undo / redo
+  // signals, e.g. when it is loaded: in this case we resynchronize.
+  if (m_backup.savedUndo.size() != m_stack.undoable().size()
+      || m_backup.savedRedo.size() != m_stack.redoable().size())
   {
-      for(int i = 0; i < index - m_previousIndex; i++)
-      {
-          m_backup.savedUndo.push(m_savedRedo.pop());
-      }
+    m_backup = CommandStackBackup{m_stack};
+    compact();
+  }
+}
+
+void CommandBackupFile::append(quint8 type, QByteArray payload)
+{
+  if (++m_recordsSinceSnapshot >= compaction_threshold)
+  {
+    compact();
+    return;
+  }
+
+  {
+    std::lock_guard lck{m_mutex};
+    m_pending.push_back({type, std::move(payload)});
+  }
+  notify();
+}
+
+void CommandBackupFile::compact()
+{
+  // The serialization of the stacks happens in the write thread:
+  // QStack being implicitly shared, what we send is an immutable copy.
+  m_recordsSinceSnapshot = 0;
+  {
+    std::lock_guard lck{m_mutex};
+
+    // Anything that was not written yet is superseded by the snapshot
+    m_pending.clear();
+    m_pending.push_back({Snapshot, {}});
+    m_snapshotUndo = m_backup.savedUndo;
+    m_snapshotRedo = m_backup.savedRedo;
+  }
+  notify();
+}
+
+void CommandBackupFile::notify()
+{
+#if !defined(__EMSCRIPTEN__)
+  m_cv.notify_one();
+#else
+  writePending();
+#endif
+}
+
+void CommandBackupFile::writeThread()
+{
+  for (;;)
+  {
+    bool running{};
+    {
+      std::unique_lock lck{m_mutex};
+      m_cv.wait(lck, [&] { return !m_pending.empty() || !m_running; });
+      running = m_running;
+    }
+
+    writePending();
+
+    if (!running)
+      return;
   }
-  else if(index < m_previousIndex)
+}
+
+void CommandBackupFile::writePending()
+{
+  std::vector<PendingRecord> records;
+  QStack<CommandData> undo, redo;
   {
-      for(int i = 0; i < m_previousIndex - index ; i++)
+    std::lock_guard lck{m_mutex};
+    records.swap(m_pending);
+    if (!records.empty() && records.front().type == Snapshot)
+    {
+      undo.swap(m_snapshotUndo);
+      redo.swap(m_snapshotRedo);
+    }
+  }
+
+  if (records.empty())
+    return;
+
+  for (auto& rec : records)
+  {
+    if (rec.type == Snapshot)
+    {
+      // Write the compacted journal to a new file which atomically
+      // replaces the previous one, so that there is always a loadable file.
+      m_journal.close();
+
+      QSaveFile file{m_fileName};
+      if (file.open(QIODevice::WriteOnly))
       {
-          m_backup.savedRedo.push(m_savedUndo.pop());
+        QDataStream s{&file};
+        s << journal_magic;
+        file.write(encodeRecord(Snapshot, encodeSnapshot(undo, redo)));
+        if (!file.commit())
+          qDebug() << "Could not write the command backup: " << file.errorString();
       }
+      m_journal.open(QIODevice::WriteOnly | QIODevice::Append);
+    }
+    else if (m_journal.isOpen())
+    {
+      m_journal.write(encodeRecord(rec.type, rec.payload));
+    }
   }
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  m_journal.flush();
 }
 
-void CommandBackupFile::commit()
+bool CommandBackupFile::restore(
+    const QByteArray& data,
+    std::vector<CommandData>& undoStack,
+    std::vector<CommandData>& redoStack)
 {
-  // OPTIMIZEME: right now all the data is flushed each time.
-  // It should be better to only incrementally modify the file.
-  // See :
-  // http://www.boost.org/doc/libs/1_59_0/doc/html/interprocess/sharedmemorybetweenprocesses.html#interprocess.sharedmemorybetweenprocesses.mapped_file
+  undoStack.clear();
+  redoStack.clear();
+
+  QDataStream s{data};
+  quint32 magic{};
+  s >> magic;
+  if (magic != journal_magic)
+    return restoreLegacy(data, undoStack, redoStack);
 
-  // Another possibility would be to save the commands to a db ?
-  m_file.resize(0);
-  m_file.reset();
+  bool ok = false;
+  while (!s.atEnd())
+  {
+    quint8 type{};
+    quint32 size{};
+    quint16 checksum{};
+    s >> type >> size >> checksum;
+    if (s.status() != QDataStream::Ok || size > quint32(data.size() - s.device()->pos()))
+      break;
+
+    QByteArray payload(int(size), Qt::Uninitialized);
+    s.readRawData(payload.data(), int(size));
+    if (qChecksum(payload.constData(), payload.size()) != checksum)
+    {
+      qDebug() << "Command backup: corrupted record, stopping there";
+      break;
+    }
 
-  DataStream::Serializer ser(&m_file);
-  ser.readFrom(m_stack);
+    switch (type)
+    {
+      case Snapshot:
+        ok = restoreLegacy(payload, undoStack, redoStack);
+        break;
+      case Push:
+        undoStack.push_back(DataStream::Deserializer::unmarshall<CommandData>(payload));
+        redoStack.clear();
+        break;
+      case Undo:
+        if (!undoStack.empty())
+        {
+          redoStack.push_back(std::move(undoStack.back()));
+          undoStack.pop_back();
+        }
+        break;
+      case Redo:
+        if (!redoStack.empty())
+        {
+          undoStack.push_back(std::move(redoStack.back()));
+          redoStack.pop_back();
+        }
+        break;
+      default:
+        break;
+    }
+
+    if (!ok)
+      break;
+  }
 
-  m_file.flush();
+  return ok;
 }
 }
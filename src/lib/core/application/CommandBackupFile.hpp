@@ -2,10 +2,15 @@
 #include <score/command/Command.hpp>
 #include <score/command/CommandData.hpp>
 
+#include <QFile>
 #include <QObject>
 #include <QStack>
 #include <QString>
-#include <QTemporaryFile>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace score
 {
@@ -25,29 +30,78 @@ struct CommandStackBackup
  * @brief Abstraction over the backup of commands
  *
  * Synchronizes the commands of a document to an on-disk file,
- * by maintaining serialized stacks of commands at each new command.
+ * by appending each new command, undo and redo to a journal.
  *
  * This way, if there is a crash, the document can be restored from the
  * last successful command and only the latest user action is lost.
+ *
+ * The journal is a sequence of checksummed records:
+ * * a snapshot of the whole undo / redo stacks, at the beginning of the
+ * file,
+ * * the commands pushed since then, and undo / redo markers.
+ *
+ * It is written by a background thread and periodically compacted into a
+ * single snapshot. When reading it back, everything up to the first
+ * incomplete or corrupted record is restored.
  */
 class CommandBackupFile final : public QObject
 {
 public:
   CommandBackupFile(const score::CommandStack& stack, QObject* parent);
+  ~CommandBackupFile();
   QString fileName() const;
 
+  //! The serialized commands, as they currently are in the stack
+  const CommandStackBackup& backup() const noexcept { return m_backup; }
+
+  /**
+   * @brief Rebuilds the command stacks stored in a backup file.
+   *
+   * Also supports the files written by previous versions, which
+   * contained the whole serialized command stack.
+   *
+   * @return false if nothing could be recovered.
+   */
+  static bool restore(
+      const QByteArray& data,
+      std::vector<CommandData>& undoStack,
+      std::vector<CommandData>& redoStack);
+
 private:
   void on_push();
   void on_undo();
   void on_redo();
-  void on_indexChanged();
+  void on_stackChanged();
+
+  //! Schedules a record to be written to disk.
+  void append(quint8 type, QByteArray payload);
 
-  //! Writes the current buffers to disk.
-  void commit();
+  //! Schedules the replacement of the journal by a snapshot of the stacks.
+  void compact();
+
+  //! Wakes up the write thread, or writes synchronously if there is none.
+  void notify();
+  void writeThread();
+  void writePending();
 
   const score::CommandStack& m_stack;
   CommandStackBackup m_backup;
+  QString m_fileName;
+  QFile m_journal;
+  int m_recordsSinceSnapshot{};
+
+  struct PendingRecord
+  {
+    quint8 type{};
+    QByteArray payload;
+  };
 
-  QTemporaryFile m_file;
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<PendingRecord> m_pending;
+  QStack<CommandData> m_snapshotUndo;
+  QStack<CommandData> m_snapshotRedo;
+  bool m_running{true};
 };
 }
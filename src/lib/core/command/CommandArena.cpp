@@ -0,0 +1,201 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "CommandArena.hpp"
+
+#include <score/application/ApplicationContext.hpp>
+#include <score/document/DocumentContext.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+#include <score/tools/Debug.hpp>
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QObject>
+
+#include <memory>
+#include <stdexcept>
+
+namespace score
+{
+namespace
+{
+// Small blobs are not worth compressing
+static constexpr int compression_threshold = 256;
+}
+
+CommandArena::CommandArena(qint64 budget)
+    : m_budget{budget}
+{
+}
+
+CommandArena::~CommandArena() = default;
+
+CommandArena::Key CommandArena::store(const QByteArray& data)
+{
+  Key key = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+  if (auto it = m_blobs.find(key); it != m_blobs.end())
+  {
+    it.value().refcount++;
+    return key;
+  }
+
+  Blob b;
+  b.refcount = 1;
+  if (data.size() > compression_threshold)
+  {
+    b.data = qCompress(data, 1);
+    b.compressed = true;
+  }
+  else
+  {
+    b.data = data;
+  }
+  b.size = b.data.size();
+
+  m_memory += b.size;
+  m_blobs.emplace(key, std::move(b));
+  m_order.push_back(key);
+
+  if (m_memory > m_budget)
+    spill();
+
+  return key;
+}
+
+void CommandArena::release(const Key& key) noexcept
+{
+  auto it = m_blobs.find(key);
+  SCORE_ASSERT(it != m_blobs.end());
+  if (--it.value().refcount > 0)
+    return;
+
+  if (it->second.offset >= 0)
+    m_spilled--;
+  else
+    m_memory -= it->second.size;
+  m_blobs.erase(it);
+
+  // Nothing references the file anymore: its space can be reused
+  if (m_spilled == 0 && m_fileSize > 0)
+  {
+    m_file.resize(0);
+    m_fileSize = 0;
+  }
+
+  // Released blobs are left in the order list until they would be spilled
+  if (m_order.size() > 2 * m_blobs.size() + 64)
+  {
+    m_order.erase(
+        std::remove_if(
+            m_order.begin(),
+            m_order.end(),
+            [this](const Key& k) {
+              auto it = m_blobs.find(k);
+              return it == m_blobs.end() || it->second.offset >= 0;
+            }),
+        m_order.end());
+  }
+}
+
+QByteArray CommandArena::load(const Key& key) const
+{
+  auto it = m_blobs.find(key);
+  if (it == m_blobs.end())
+    throw std::runtime_error("CommandArena::load: unknown command");
+
+  const Blob& b = it->second;
+  QByteArray data = b.data;
+  if (b.offset >= 0)
+  {
+    if (!m_file.seek(b.offset) || (data = m_file.read(b.size)).size() != b.size)
+      throw std::runtime_error(
+          QObject::tr("Could not read the undo history from the disk.").toStdString());
+  }
+
+  return b.compressed ? qUncompress(data) : data;
+}
+
+void CommandArena::spill()
+{
+  if (!m_file.isOpen())
+  {
+    m_file.setFileTemplate(QDir::tempPath() + QStringLiteral("/score-undo-XXXXXX"));
+    if (!m_file.open())
+    {
+      qDebug() << "CommandArena: could not open" << m_file.fileTemplate();
+      return;
+    }
+  }
+
+  // Spill more than needed so that it does not happen on every command
+  while (m_memory > m_budget / 2 && !m_order.empty())
+  {
+    auto it = m_blobs.find(m_order.front());
+    m_order.pop_front();
+    if (it == m_blobs.end() || it->second.offset >= 0)
+      continue;
+
+    Blob& b = it.value();
+    if (!m_file.seek(m_fileSize) || m_file.write(b.data) != b.size)
+    {
+      qDebug() << "CommandArena: could not write to" << m_file.fileName();
+      m_order.push_front(it->first);
+      return;
+    }
+
+    b.offset = m_fileSize;
+    b.data = QByteArray{};
+    m_fileSize += b.size;
+    m_memory -= b.size;
+    m_spilled++;
+  }
+}
+
+StoredCommand::StoredCommand(const score::Command& cmd, CommandArena& arena)
+    : m_arena{arena}
+    , m_parentKey{cmd.parentKey()}
+    , m_commandKey{cmd.key()}
+    , m_description{cmd.description()}
+    , m_key{arena.store(cmd.serialize())}
+{
+}
+
+StoredCommand::~StoredCommand()
+{
+  m_arena.release(m_key);
+}
+
+score::Command* StoredCommand::instantiate(const score::ApplicationContext& ctx) const
+{
+  CommandData data;
+  data.parentKey = m_parentKey;
+  data.commandKey = m_commandKey;
+  data.data = m_arena.load(m_key);
+  return ctx.instantiateUndoCommand(data);
+}
+
+void StoredCommand::undo(const score::DocumentContext& ctx) const
+{
+  std::unique_ptr<score::Command> cmd{instantiate(ctx.app)};
+  cmd->undo(ctx);
+}
+
+void StoredCommand::redo(const score::DocumentContext& ctx) const
+{
+  std::unique_ptr<score::Command> cmd{instantiate(ctx.app)};
+  cmd->redo(ctx);
+}
+
+void StoredCommand::serializeImpl(DataStreamInput& s) const
+{
+  // Same bytes as the original command's serialization
+  const auto data = m_arena.load(m_key);
+  s.stream.writeRawData(data.constData(), data.size());
+}
+
+void StoredCommand::deserializeImpl(DataStreamOutput&)
+{
+  // Stored commands are only created from existing commands
+  SCORE_ABORT;
+}
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <score/command/Command.hpp>
+#include <score/command/CommandData.hpp>
+#include <score/tools/std/HashMap.hpp>
+
+#include <QByteArray>
+#include <QTemporaryFile>
+
+#include <score_lib_base_export.h>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+
+namespace score
+{
+/**
+ * @brief Storage for the serialized commands of the undo history.
+ *
+ * Blobs are compressed and content-addressed: identical blobs, e.g. the
+ * same objects pasted many times, are only stored once.
+ *
+ * When the compressed blobs use more memory than the budget, the oldest
+ * ones are moved to a temporary file and are read back from it when needed.
+ */
+class SCORE_LIB_BASE_EXPORT CommandArena
+{
+public:
+  using Key = QByteArray;
+
+  explicit CommandArena(qint64 budget);
+  ~CommandArena();
+
+  //! Stores a blob and returns its key. Each store must be matched by a release.
+  Key store(const QByteArray& data);
+  void release(const Key& key) noexcept;
+
+  //! Throws if the blob cannot be read back from the disk.
+  QByteArray load(const Key& key) const;
+
+  qint64 memoryUsage() const noexcept { return m_memory; }
+
+private:
+  struct Blob
+  {
+    QByteArray data;
+    qint64 offset{-1};
+    int size{};
+    int refcount{};
+    bool compressed{};
+  };
+
+  // The keys are hashes already
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& k) const noexcept
+    {
+      std::size_t h{};
+      std::memcpy(&h, k.constData(), std::min(sizeof(h), std::size_t(k.size())));
+      return h;
+    }
+  };
+
+  void spill();
+
+  score::hash_map<Key, Blob, KeyHash> m_blobs;
+  // Blobs in memory, oldest first
+  std::deque<Key> m_order;
+
+  mutable QTemporaryFile m_file;
+  qint64 m_fileSize{};
+  int m_spilled{};
+
+  qint64 m_budget{};
+  qint64 m_memory{};
+};
+
+/**
+ * @brief A command of the undo history stored in a CommandArena.
+ *
+ * Replaces commands which are deep in the undo or redo stack: only their
+ * keys and description are kept in memory.
+ * The actual command is recreated with the command factories when
+ * it has to be undone or redone.
+ */
+class SCORE_LIB_BASE_EXPORT StoredCommand final : public score::Command
+{
+public:
+  StoredCommand(const score::Command& cmd, CommandArena& arena);
+  ~StoredCommand() override;
+
+  //! Recreates the original command
+  score::Command* instantiate(const score::ApplicationContext& ctx) const;
+
+  void undo(const score::DocumentContext& ctx) const override;
+  void redo(const score::DocumentContext& ctx) const override;
+
+  const CommandGroupKey& parentKey() const noexcept override { return m_parentKey; }
+  const CommandKey& key() const noexcept override { return m_commandKey; }
+  QString description() const override { return m_description; }
+
+protected:
+  void serializeImpl(DataStreamInput&) const override;
+  void deserializeImpl(DataStreamOutput&) override;
+
+private:
+  CommandArena& m_arena;
+  CommandGroupKey m_parentKey;
+  CommandKey m_commandKey;
+  QString m_description;
+  CommandArena::Key m_key;
+};
+}
@@ -1,9 +1,12 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <score/application/GUIApplicationContext.hpp>
 #include <score/command/Command.hpp>
 #include <score/command/Validity/ValidityChecker.hpp>
 #include <score/document/DocumentContext.hpp>
 
+#include <core/application/ApplicationSettings.hpp>
+#include <core/command/CommandArena.hpp>
 #include <core/command/CommandStack.hpp>
 #include <core/document/Document.hpp>
 
@@ -11,8 +14,16 @@
 W_OBJECT_IMPL(score::CommandStack)
 namespace score
 {
+namespace
+{
+// Number of commands kept as is at the top of each stack
+static constexpr int live_commands = 32;
+}
+
 CommandStack::CommandStack(const score::Document& ctx, QObject* parent)
-    : m_checker{score::AppComponents().interfaces<ValidityCheckerList>(), ctx}
+    : m_arena{std::make_unique<CommandArena>(
+        qint64(score::AppContext().applicationSettings.undoMemory) * 1024 * 1024)}
+    , m_checker{score::AppComponents().interfaces<ValidityCheckerList>(), ctx}
     , m_ctx{ctx.context()}
 {
   this->setObjectName("CommandStack");
@@ -119,9 +130,10 @@ void CommandStack::setIndex(int index)
 void CommandStack::undoQuiet()
 {
   updateStack([&]() {
-    auto cmd = m_undoable.pop();
+    auto cmd = pop(m_undoable);
     cmd->undo(m_ctx);
     m_redoable.push(cmd);
+    compact(m_redoable, m_compactedRedo);
 
     saveIndexChanged(m_savedIndex == this->currentIndex());
     sig_undo();
@@ -131,10 +143,11 @@ void CommandStack::undoQuiet()
 void CommandStack::redoQuiet()
 {
   updateStack([&]() {
-    auto cmd = m_redoable.pop();
+    auto cmd = pop(m_redoable);
     cmd->redo(m_ctx);
 
     m_undoable.push(cmd);
+    compact(m_undoable, m_compactedUndo);
 
     saveIndexChanged(m_savedIndex == this->currentIndex());
     sig_redo();
@@ -163,7 +176,9 @@ void CommandStack::push(Command* cmd)
     {
       qDeleteAll(m_redoable);
       m_redoable.clear();
+      m_compactedRedo = 0;
     }
+    compact(m_undoable, m_compactedUndo);
 
     sig_push();
   });
@@ -190,7 +205,9 @@ void CommandStack::pushQuiet(Command* cmd)
     {
       qDeleteAll(m_redoable);
       m_redoable.clear();
+      m_compactedRedo = 0;
     }
+    compact(m_undoable, m_compactedUndo);
 
     sig_push();
   });
@@ -205,6 +222,51 @@ void CommandStack::setSavedIndex(int index)
   }
 }
 
+void CommandStack::compact()
+{
+  // The stacks may have been modified directly
+  m_compactedUndo = 0;
+  m_compactedRedo = 0;
+  compact(m_undoable, m_compactedUndo);
+  compact(m_redoable, m_compactedRedo);
+}
+
+Command* CommandStack::pop(QStack<Command*>& stack)
+{
+  // Recreate the command before popping it, so that it is not lost if this fails
+  if (auto stored = dynamic_cast<StoredCommand*>(stack.top()))
+  {
+    stack.top() = stored->instantiate(m_ctx.app);
+    delete stored;
+  }
+
+  auto cmd = stack.pop();
+  if (&stack == &m_undoable)
+    m_compactedUndo = std::min(m_compactedUndo, int(stack.size()));
+  else
+    m_compactedRedo = std::min(m_compactedRedo, int(stack.size()));
+  return cmd;
+}
+
+void CommandStack::compact(QStack<Command*>& stack, int& compacted)
+{
+  const auto& components = m_ctx.app.components;
+  for (; compacted < stack.size() - live_commands; compacted++)
+  {
+    auto& cmd = stack[compacted];
+    if (dynamic_cast<StoredCommand*>(cmd))
+      continue;
+
+    // Commands which cannot be recreated are kept as is
+    if (!components.hasUndoCommand(cmd->parentKey(), cmd->key()))
+      continue;
+
+    auto stored = new StoredCommand{*cmd, *m_arena};
+    delete cmd;
+    cmd = stored;
+  }
+}
+
 CommandStackFacade::CommandStackFacade(CommandStack& stack) : m_stack{stack} { }
 
 const DocumentContext& CommandStackFacade::context() const
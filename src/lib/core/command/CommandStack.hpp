@@ -8,8 +8,11 @@
 
 #include <verdigris>
 
+#include <memory>
+
 namespace score
 {
+class CommandArena;
 class Document;
 
 /**
@@ -21,6 +24,10 @@ class Document;
  * This class should never be used directly to send commands.
  * Instead, the various command dispatchers, in score/command/Dispatchers
  * should be used.
+ *
+ * To bound the memory used by the history, the commands which are deep
+ * in the undo or redo stack are replaced by a score::StoredCommand:
+ * the undoable() and redoable() stacks may contain such commands.
  */
 class SCORE_LIB_BASE_EXPORT CommandStack final : public QObject
 {
@@ -202,10 +209,22 @@ public:
 
   void setSavedIndex(int index);
 
+  //! Moves the commands which are deep in the stacks to the command arena.
+  //! To be called after modifying undoable() or redoable() directly.
+  void compact();
+
 private:
+  score::Command* pop(QStack<score::Command*>& stack);
+  void compact(QStack<score::Command*>& stack, int& compacted);
+
   QStack<score::Command*> m_undoable;
   QStack<score::Command*> m_redoable;
 
+  std::unique_ptr<CommandArena> m_arena;
+  // Commands below these indices are stored or cannot be stored
+  int m_compactedUndo{};
+  int m_compactedRedo{};
+
   int m_savedIndex{};
 
   DocumentValidator m_checker;
@@ -7,39 +7,78 @@
 #include <core/command/CommandStack.hpp>
 namespace score
 {
-template <typename RedoFun>
+/**
+ * @brief Loads a command stack in a document.
+ *
+ * The document already contains the effect of the first appliedCount
+ * commands (e.g. when it comes from an autosave): the following ones
+ * are redone, or the previous ones undone, to reach the current index of the
+ * stack.
+ */
+template <typename RedoFun, typename UndoFun>
 void loadCommandStack(
     const score::ApplicationComponents& components,
-    DataStreamWriter& writer,
+    const std::vector<score::CommandData>& undoStack,
+    const std::vector<score::CommandData>& redoStack,
+    int appliedCount,
     score::CommandStack& stack,
-    RedoFun redo_fun)
+    RedoFun redo_fun,
+    UndoFun undo_fun)
 {
-  std::vector<score::CommandData> undoStack, redoStack;
-  writer.writeTo(undoStack);
-  writer.writeTo(redoStack);
-
-  writer.checkDelimiter();
-
   stack.undoable().clear();
   stack.redoable().clear();
 
   stack.updateStack([&]() {
     stack.setSavedIndex(-1);
 
+    // All the commands in order, as in CommandStack::command
+    std::vector<score::Command*> commands;
+    commands.reserve(undoStack.size() + redoStack.size());
     for (const auto& elt : undoStack)
-    {
-      auto cmd = components.instantiateUndoCommand(elt);
+      commands.push_back(components.instantiateUndoCommand(elt));
+    for (auto it = redoStack.rbegin(); it != redoStack.rend(); ++it)
+      commands.push_back(components.instantiateUndoCommand(*it));
 
-      redo_fun(cmd);
-      stack.undoable().push(cmd);
-    }
+    const int current = undoStack.size();
+    for (int i = appliedCount; i < current; i++)
+      redo_fun(commands[i]);
+    for (int i = appliedCount - 1; i >= current; i--)
+      undo_fun(commands[i]);
 
-    for (const auto& elt : redoStack)
-    {
-      auto cmd = components.instantiateUndoCommand(elt);
+    for (int i = 0; i < current; i++)
+      stack.undoable().push(commands[i]);
+    for (int i = int(commands.size()) - 1; i >= current; i--)
+      stack.redoable().push(commands[i]);
 
-      stack.redoable().push(cmd);
-    }
+    stack.compact();
   });
 }
+
+template <typename RedoFun>
+void loadCommandStack(
+    const score::ApplicationComponents& components,
+    const std::vector<score::CommandData>& undoStack,
+    const std::vector<score::CommandData>& redoStack,
+    score::CommandStack& stack,
+    RedoFun redo_fun)
+{
+  loadCommandStack(
+      components, undoStack, redoStack, 0, stack, std::move(redo_fun), [](auto) {});
+}
+
+template <typename RedoFun>
+void loadCommandStack(
+    const score::ApplicationComponents& components,
+    DataStreamWriter& writer,
+    score::CommandStack& stack,
+    RedoFun redo_fun)
+{
+  std::vector<score::CommandData> undoStack, redoStack;
+  writer.writeTo(undoStack);
+  writer.writeTo(redoStack);
+
+  writer.checkDelimiter();
+
+  loadCommandStack(components, undoStack, redoStack, stack, std::move(redo_fun));
+}
 }
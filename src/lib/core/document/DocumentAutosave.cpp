@@ -0,0 +1,373 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "DocumentAutosave.hpp"
+
+#include "Document.hpp"
+#include "DocumentContainer.hpp"
+#include "DocumentModel.hpp"
+
+#include <score/command/AggregateCommand.hpp>
+#include <score/plugins/SerializableHelpers.hpp>
+#include <score/plugins/documentdelegate/plugin/SerializableDocumentPlugin.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+#include <score/tools/Bind.hpp>
+
+#include <core/application/CommandBackupFile.hpp>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QVector>
+
+#include <algorithm>
+
+namespace score
+{
+namespace
+{
+// "SCA1"
+static constexpr quint32 autosave_magic = 0x53434131;
+static constexpr int autosave_interval = 30000;
+// Commands replayed at most on restore instead of serializing the document model
+static constexpr int64_t autosave_model_changes = 100;
+
+QString manifestPath(const QString& path)
+{
+  return path + QStringLiteral(".autosave");
+}
+
+QString chunksPath(const QString& path)
+{
+  return path + QStringLiteral(".chunks");
+}
+
+// Commands are ordered like in CommandStack::command
+template <typename Undo, typename Redo>
+QByteArray hashCommandsImpl(const Undo& undo, const Redo& redo, int count)
+{
+  const int undo_n = undo.size();
+  const int redo_n = redo.size();
+  if (count < 0 || count > undo_n + redo_n)
+    return {};
+
+  QCryptographicHash hash{QCryptographicHash::Sha1};
+  for (int i = 0; i < count; i++)
+  {
+    const CommandData& cmd = i < undo_n ? undo[i] : redo[redo_n - (i - undo_n) - 1];
+    const auto& parent = cmd.parentKey.toString();
+    const auto& key = cmd.commandKey.toString();
+    hash.addData(parent.data(), parent.size());
+    hash.addData(key.data(), key.size());
+    hash.addData(cmd.data);
+  }
+  return hash.result();
+}
+
+bool writeFile(const QString& path, const QByteArray& data)
+{
+  QSaveFile f{path};
+  if (!f.open(QIODevice::WriteOnly))
+    return false;
+  f.write(data);
+  return f.commit();
+}
+}
+
+DocumentAutosave::DocumentAutosave(
+    score::Document& doc,
+    const CommandBackupFile& commands,
+    const QString& path,
+    QObject* parent)
+    : QObject{parent}, m_doc{doc}, m_commands{commands}, m_path{path}
+{
+  m_thread = std::thread{[this] { writeThread(); }};
+
+  // The commands tell which chunks they modify
+  auto& stack = doc.commandStack();
+  con(stack, &CommandStack::sig_push, this, [this, &stack] {
+    commandApplied(*stack.undoable().top());
+  });
+  con(stack, &CommandStack::sig_redo, this, [this, &stack] {
+    commandApplied(*stack.undoable().top());
+  });
+  con(stack, &CommandStack::sig_undo, this, [this, &stack] {
+    commandApplied(*stack.redoable().top());
+  });
+  con(stack, &CommandStack::stackChanged, this, [this] {
+    // The stacks were modified directly: anything may have changed
+    if (!m_commandApplied)
+      markAllDirty();
+    m_commandApplied = false;
+    m_changes++;
+  });
+
+  m_timer.setInterval(autosave_interval);
+  con(m_timer, &QTimer::timeout, this, &DocumentAutosave::save);
+  m_timer.start();
+}
+
+DocumentAutosave::~DocumentAutosave()
+{
+  m_timer.stop();
+  {
+    std::lock_guard lck{m_mutex};
+    m_running = false;
+  }
+  m_cv.notify_all();
+  m_thread.join();
+}
+
+void DocumentAutosave::save()
+{
+  // Nothing changed, or the previous autosave is still being written
+  if (m_changes == m_savedChanges || m_saving.load(std::memory_order_acquire))
+    return;
+
+  // All the chunks of an autosave are at the same position in the command
+  // stack: while the model does not need to be serialized again, the
+  // commands backup covers the changes since the previous autosave.
+  // The first autosave of the document always has to serialize it.
+  if (m_model.dirty && !m_model.data.isEmpty() && m_modelChanges < autosave_model_changes)
+    return;
+
+  // Only the chunks modified since the previous autosave are serialized again
+  if (m_model.dirty)
+  {
+    m_model.data = m_doc.saveDocumentModelAsByteArray();
+    m_model.dirty = false;
+    m_modelChanges = 0;
+  }
+
+  std::vector<Chunk> plugins;
+  for (const auto& plugin : m_doc.model().pluginModels())
+  {
+    if (auto serializable_plugin = qobject_cast<SerializableDocumentPlugin*>(plugin))
+    {
+      auto it = std::find_if(m_plugins.begin(), m_plugins.end(), [=](const Chunk& c) {
+        return c.plugin.data() == serializable_plugin;
+      });
+      Chunk chunk = it != m_plugins.end()
+                        ? std::move(*it)
+                        : Chunk{serializable_plugin, serializable_plugin->commandGroup()};
+      if (chunk.dirty)
+      {
+        chunk.data.clear();
+        DataStream::Serializer s{&chunk.data};
+        s.readFrom(*serializable_plugin);
+        chunk.dirty = false;
+      }
+      plugins.push_back(std::move(chunk));
+    }
+  }
+  m_plugins = std::move(plugins);
+
+  // Implicitly shared: the write thread gets copies which are not modified anymore
+  std::vector<QByteArray> chunks;
+  chunks.reserve(1 + m_plugins.size());
+  chunks.push_back(m_model.data);
+  for (const auto& chunk : m_plugins)
+    chunks.push_back(chunk.data);
+
+  const auto& backup = m_commands.backup();
+  QStack<CommandData> undo = backup.savedUndo;
+  QStack<CommandData> redo = backup.savedRedo;
+  const int index = undo.size();
+
+  m_savedChanges = m_changes;
+  m_saving.store(true, std::memory_order_release);
+
+  enqueue([this, chunks = std::move(chunks), undo, redo, index] {
+    const QString dir = chunksPath(m_path);
+    QDir{}.mkpath(dir);
+
+    // Only the chunks which changed since the previous autosave are written
+    QVector<QString> names;
+    for (const auto& chunk : chunks)
+    {
+      QString name = QCryptographicHash::hash(chunk, QCryptographicHash::Sha1).toHex();
+      const QString file = dir + '/' + name;
+      const bool written
+          = std::find(m_writtenChunks.begin(), m_writtenChunks.end(), name)
+            != m_writtenChunks.end();
+      if (!written && !QFile::exists(file))
+      {
+        if (!writeFile(file, chunk))
+        {
+          qDebug() << "Autosave: could not write" << file;
+          m_saving.store(false, std::memory_order_release);
+          return;
+        }
+      }
+      names.push_back(std::move(name));
+    }
+
+    QByteArray manifest;
+    {
+      QDataStream s{&manifest, QIODevice::WriteOnly};
+      s << autosave_magic << qint32(index) << hashCommandsImpl(undo, redo, index) << names;
+    }
+
+    if (writeFile(manifestPath(m_path), manifest))
+    {
+      // Remove the chunks which are not referenced anymore
+      for (const auto& name : m_writtenChunks)
+      {
+        if (!names.contains(name))
+          QFile::remove(dir + '/' + name);
+      }
+      m_writtenChunks.assign(names.begin(), names.end());
+    }
+
+    m_saving.store(false, std::memory_order_release);
+  });
+}
+
+void DocumentAutosave::commandApplied(const Command& cmd)
+{
+  m_commandApplied = true;
+  markDirty(cmd);
+}
+
+void DocumentAutosave::markDirty(const Command& cmd)
+{
+  if (auto aggregate = dynamic_cast<const AggregateCommand*>(&cmd))
+  {
+    for (auto sub : aggregate->commands())
+      markDirty(*sub);
+    return;
+  }
+
+  const auto& group = cmd.parentKey();
+  for (const auto& plugin : m_doc.model().pluginModels())
+  {
+    if (auto serializable_plugin = qobject_cast<SerializableDocumentPlugin*>(plugin))
+    {
+      if (serializable_plugin->commandGroup() == group)
+      {
+        markDirty(*serializable_plugin);
+        return;
+      }
+    }
+  }
+
+  // Otherwise, the command may modify the model and the plug-ins
+  // which do not tell which commands modify them.
+  m_model.dirty = true;
+  m_modelChanges++;
+  for (auto& chunk : m_plugins)
+  {
+    if (!chunk.group)
+      chunk.dirty = true;
+  }
+}
+
+void DocumentAutosave::markDirty(const SerializableDocumentPlugin& plugin)
+{
+  // Plug-ins without a chunk yet are serialized at the next autosave anyway
+  for (auto& chunk : m_plugins)
+  {
+    if (chunk.plugin.data() == &plugin)
+      chunk.dirty = true;
+  }
+}
+
+void DocumentAutosave::markAllDirty()
+{
+  m_model.dirty = true;
+  m_modelChanges++;
+  for (auto& chunk : m_plugins)
+    chunk.dirty = true;
+}
+
+void DocumentAutosave::enqueue(std::function<void()> job)
+{
+  {
+    std::lock_guard lck{m_mutex};
+    m_jobs.push_back(std::move(job));
+  }
+  m_cv.notify_one();
+}
+
+void DocumentAutosave::writeThread()
+{
+  std::vector<std::function<void()>> jobs;
+  for (;;)
+  {
+    bool running{};
+    {
+      std::unique_lock lck{m_mutex};
+      m_cv.wait(lck, [&] { return !m_jobs.empty() || !m_running; });
+      jobs.swap(m_jobs);
+      running = m_running;
+    }
+
+    for (auto& job : jobs)
+      job();
+    jobs.clear();
+
+    if (!running)
+      return;
+  }
+}
+
+std::optional<DocumentAutosave::Restored> DocumentAutosave::load(const QString& path)
+{
+  QFile f{manifestPath(path)};
+  if (!f.open(QIODevice::ReadOnly))
+    return std::nullopt;
+
+  quint32 magic{};
+  qint32 index{};
+  QByteArray commandsHash;
+  QVector<QString> names;
+
+  QDataStream s{&f};
+  s >> magic >> index >> commandsHash >> names;
+  if (s.status() != QDataStream::Ok || magic != autosave_magic || names.empty())
+    return std::nullopt;
+
+  std::vector<QByteArray> chunks;
+  for (const auto& name : names)
+  {
+    QFile chunk{chunksPath(path) + '/' + name};
+    if (!chunk.open(QIODevice::ReadOnly))
+      return std::nullopt;
+
+    auto data = chunk.readAll();
+    if (QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex() != name.toLatin1())
+    {
+      qDebug() << "Autosave: corrupted chunk" << name;
+      return std::nullopt;
+    }
+    chunks.push_back(std::move(data));
+  }
+
+  // Reassemble the document as Document::saveAsByteArray does.
+  // It is not worth compressing since it is read right away.
+  const QByteArray model = std::move(chunks.front());
+  chunks.erase(chunks.begin());
+
+  Restored res;
+  res.document = DocumentContainer::write(model, chunks, DocumentContainer::Uncompressed);
+  res.commandIndex = index;
+  res.commandsHash = std::move(commandsHash);
+  return res;
+}
+
+void DocumentAutosave::remove(const QString& path)
+{
+  QFile::remove(manifestPath(path));
+  QDir{chunksPath(path)}.removeRecursively();
+}
+
+QByteArray DocumentAutosave::hashCommands(
+    const std::vector<CommandData>& undo,
+    const std::vector<CommandData>& redo,
+    int count)
+{
+  return hashCommandsImpl(undo, redo, count);
+}
+}
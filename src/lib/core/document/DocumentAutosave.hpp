@@ -0,0 +1,127 @@
+#pragma once
+#include <score/command/CommandData.hpp>
+#include <score/plugins/documentdelegate/plugin/SerializableDocumentPlugin.hpp>
+
+#include <QByteArray>
+#include <QObject>
+#include <QPointer>
+#include <QStack>
+#include <QString>
+#include <QTimer>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace score
+{
+class Command;
+class CommandBackupFile;
+class Document;
+
+/**
+ * @brief Periodic backup of the document model.
+ *
+ * Without it, restoring a document after a crash requires replaying every
+ * command since the document was opened.
+ *
+ * The document is split in chunks: the document model and each document
+ * plug-in. The commands applied on the stack mark the chunks they modify
+ * as dirty (see SerializableDocumentPlugin::commandGroup), and only the
+ * dirty chunks are serialized again ; the others are reused from the
+ * previous autosave. The serialization happens on the GUI thread, which
+ * owns the model ; the serialized chunks are immutable copies from which
+ * the background thread hashes and writes the files. Chunks whose content
+ * is already on disk are not written again.
+ *
+ * The document model is by far the largest chunk: it is only serialized
+ * again once enough commands modified it. Until then the autosave is not
+ * updated, and a restore replays these commands from the command backup,
+ * so that a single edit does not stall the GUI on a large document.
+ *
+ * The autosave also stores its position in the command stack, and a hash
+ * of the commands before this position: on restore, it is only used if
+ * these commands match the ones in the command backup.
+ *
+ * The files are located next to the backup of the document model :
+ * * <path>.autosave is the manifest,
+ * * <path>.chunks/ contains the chunks, named after their hash.
+ *
+ * \see score::DocumentBackupManager
+ */
+class DocumentAutosave final : public QObject
+{
+public:
+  struct Restored
+  {
+    //! The document, in the same format than Document::saveAsByteArray
+    QByteArray document;
+    int commandIndex{-1};
+    QByteArray commandsHash;
+  };
+
+  DocumentAutosave(
+      score::Document& doc,
+      const CommandBackupFile& commands,
+      const QString& path,
+      QObject* parent);
+  ~DocumentAutosave();
+
+  //! Saves the document if it changed since the last autosave
+  void save();
+
+  //! Runs a function in the background thread, after the pending saves.
+  void enqueue(std::function<void()> job);
+
+  static std::optional<Restored> load(const QString& path);
+  static void remove(const QString& path);
+
+  //! Hash of the first count commands of a stack
+  static QByteArray hashCommands(
+      const std::vector<CommandData>& undo,
+      const std::vector<CommandData>& redo,
+      int count);
+
+private:
+  struct Chunk
+  {
+    QPointer<const SerializableDocumentPlugin> plugin;
+    std::optional<CommandGroupKey> group;
+    QByteArray data;
+    bool dirty{true};
+  };
+
+  void commandApplied(const Command& cmd);
+  void markDirty(const Command& cmd);
+  void markDirty(const SerializableDocumentPlugin& plugin);
+  void markAllDirty();
+  void writeThread();
+
+  score::Document& m_doc;
+  const CommandBackupFile& m_commands;
+  QString m_path;
+  QTimer m_timer;
+
+  Chunk m_model;
+  std::vector<Chunk> m_plugins;
+  bool m_commandApplied{};
+
+  int64_t m_modelChanges{};
+  int64_t m_changes{};
+  int64_t m_savedChanges{};
+  std::atomic_bool m_saving{};
+
+  // Chunks referenced by the latest manifest, only used by the write thread
+  std::vector<QString> m_writtenChunks;
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::vector<std::function<void()>> m_jobs;
+  bool m_running{true};
+};
+}
@@ -3,11 +3,14 @@
 #include "DocumentBackupManager.hpp"
 
 #include "Document.hpp"
+#include "DocumentAutosave.hpp"
 
 #include <core/application/CommandBackupFile.hpp>
 #include <core/application/OpenDocumentsFile.hpp>
 
+#include <QDebug>
 #include <QFile>
+#include <QSaveFile>
 #include <QSettings>
 #include <QVariant>
 
@@ -17,10 +20,21 @@ score::DocumentBackupManager::DocumentBackupManager(score::Document& doc)
   m_modelFile.open();
 
   m_commandFile = new CommandBackupFile{doc.commandStack(), this};
+#if !defined(__EMSCRIPTEN__)
+  m_autosave = new DocumentAutosave{doc, *m_commandFile, m_modelFile.fileName(), this};
+#endif
 }
 
 score::DocumentBackupManager::~DocumentBackupManager()
 {
+  // Stop writing the backups before removing them
+  delete m_autosave;
+  m_autosave = nullptr;
+
+  const QString commandFile = crashCommandFile().fileName();
+  delete m_commandFile;
+  m_commandFile = nullptr;
+
 #if !defined(__EMSCRIPTEN__)
   QSettings s(OpenDocumentsFile::path(), QSettings::IniFormat);
   auto existing_files = s.value("score/docs").toStringList();
@@ -28,18 +42,66 @@ score::DocumentBackupManager::~DocumentBackupManager()
   s.setValue("score/docs", existing_files);
 
   QFile(crashDataFile().fileName()).remove();
-  QFile(crashCommandFile().fileName()).remove();
+  QFile(commandFile).remove();
+  DocumentAutosave::remove(crashDataFile().fileName());
 #endif
 }
 
 void score::DocumentBackupManager::saveModelData(const QByteArray& arr)
 {
+  if (m_autosave && !m_modelFile.isOpen())
+  {
+    // The file is written by the background thread since saveModelFile:
+    // this keeps the writes in order.
+    m_autosave->enqueue([arr, target = m_modelFile.fileName()] {
+      QSaveFile out{target};
+      if (!out.open(QIODevice::WriteOnly) || out.write(arr) != arr.size() || !out.commit())
+        qDebug() << "Could not backup the document to" << target;
+    });
+    return;
+  }
+
+  if (!m_modelFile.isOpen() && !m_modelFile.open())
+  {
+    qDebug() << "Could not backup the document to" << m_modelFile.fileName();
+    return;
+  }
+
   m_modelFile.resize(0);
   m_modelFile.reset();
   m_modelFile.write(arr);
   m_modelFile.flush();
 }
 
+void score::DocumentBackupManager::saveModelFile(const QString& path)
+{
+  if (!m_autosave)
+  {
+    QFile f{path};
+    if (f.open(QIODevice::ReadOnly))
+      saveModelData(f.readAll());
+    return;
+  }
+
+  // The model file is only written from the background thread from there on,
+  // see saveModelData
+  const QString target = m_modelFile.fileName();
+  m_modelFile.close();
+
+  m_autosave->enqueue([path, target] {
+    QFile in{path};
+    QSaveFile out{target};
+    if (!in.open(QIODevice::ReadOnly) || !out.open(QIODevice::WriteOnly))
+    {
+      qDebug() << "Could not backup" << path;
+      return;
+    }
+    out.write(in.readAll());
+    if (!out.commit())
+      qDebug() << "Could not backup" << path << "to" << target;
+  });
+}
+
 QTemporaryFile& score::DocumentBackupManager::crashDataFile()
 {
   return m_modelFile;
@@ -7,6 +7,7 @@ namespace score
 {
 class CommandBackupFile;
 class Document;
+class DocumentAutosave;
 
 /**
  * @brief Handles document backup to allow restoring if there is a crash.
@@ -18,17 +19,12 @@ class Document;
  * when it was loaded, and one that saves all the command that have been
  * applied.
  *
- * TODO : update the document part each time the user saves the document. This
- * way there will be much fewer operations to apply if there is a crash.
- * However we have to be very careful in case of the user saving, and then
- * going before
- * his "saved" point in the undo / redo list.
- * Maybe we should keep the previous document saves somewhere and reload from
- * the
- * correct document save according to our position in the command stack.
+ * In addition, the document is periodically autosaved in the background so
+ * that fewer commands have to be applied if there is a crash.
  *
  * \see score::OpenDocumentsFile
  * \see score::CommandBackupFile
+ * \see score::DocumentAutosave
  * \see score::DocumentBackups
  */
 class DocumentBackupManager final : public QObject
@@ -40,6 +36,9 @@ public:
 
   void saveModelData(const QByteArray&);
 
+  //! Uses a copy of the file the document was loaded from, made in the background.
+  void saveModelFile(const QString& path);
+
   void updateBackupData();
 
 private:
@@ -49,5 +48,6 @@ private:
   score::Document& m_doc;
   QTemporaryFile m_modelFile;
   CommandBackupFile* m_commandFile{};
+  DocumentAutosave* m_autosave{};
 };
 }
@@ -6,6 +6,7 @@
 #include <score/widgets/MessageBox.hpp>
 
 #include <core/application/OpenDocumentsFile.hpp>
+#include <core/document/DocumentAutosave.hpp>
 
 #include <QApplication>
 #include <QFile>
@@ -54,7 +55,17 @@ static void loadRestorableDocumentData(
     data_file.open(QFile::ReadOnly);
     command_file.open(QFile::ReadOnly);
 
-    arr.push_back({command_filename.first, data_file.readAll(), command_file.readAll()});
+    score::RestorableDocument doc{
+        command_filename.first, data_file.readAll(), command_file.readAll()};
+    if (auto autosave = score::DocumentAutosave::load(date_filename))
+    {
+      doc.autosave = std::move(autosave->document);
+      doc.autosaveIndex = autosave->commandIndex;
+      doc.autosaveCommandsHash = std::move(autosave->commandsHash);
+    }
+    score::DocumentAutosave::remove(date_filename);
+
+    arr.push_back(std::move(doc));
 
     data_file.close();
     data_file.remove(); // Note: maybe we don't want to remove them that early?
@@ -101,6 +112,7 @@ SCORE_LIB_BASE_EXPORT void score::DocumentBackups::clear()
     for (auto it = existing_files.cbegin(); it != existing_files.cend(); ++it)
     {
       QFile{it.key()}.remove();
+      DocumentAutosave::remove(it.key());
       auto files = it.value().value<QPair<QString, QString>>();
       QFile{files.second}.remove();
     }
@@ -15,6 +15,13 @@ struct RestorableDocument
   QString filePath;
   QByteArray doc;
   QByteArray commands;
+
+  //! Latest autosave of the document, if any
+  QByteArray autosave;
+  //! Number of commands of the stack already applied in the autosave
+  int autosaveIndex{-1};
+  //! Hash of these commands, to check that they match the backed up ones
+  QByteArray autosaveCommandsHash;
 };
 
 /**
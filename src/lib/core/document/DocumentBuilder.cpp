@@ -11,8 +11,11 @@
 #include <score/tools/RandomNameProvider.hpp>
 #include <score/widgets/MessageBox.hpp>
 
+#include <core/application/CommandBackupFile.hpp>
 #include <core/command/CommandStackSerialization.hpp>
 #include <core/document/Document.hpp>
+#include <core/document/DocumentAutosave.hpp>
+#include <core/document/DocumentBackups.hpp>
 #include <core/document/DocumentBackupManager.hpp>
 #include <core/document/DocumentModel.hpp>
 #include <core/presenter/Presenter.hpp>
@@ -20,6 +23,7 @@
 
 #include <QByteArray>
 #include <QDebug>
+#include <QFileInfo>
 #include <QObject>
 #include <QString>
 #include <QVariant>
@@ -90,8 +94,13 @@ Document* DocumentBuilder::loadDocument(
 
     doclist.push_back(doc);
 
+    // Copying the loaded file is much cheaper than serializing the document again
     m_backupManager = new DocumentBackupManager{*doc};
-    m_backupManager->saveModelData(doc->saveAsByteArray());
+    if (const auto suffix = QFileInfo{filename}.suffix();
+        suffix == QLatin1String("score") || suffix == QLatin1String("scorebin"))
+      m_backupManager->saveModelFile(filename);
+    else
+      m_backupManager->saveModelData(doc->saveAsByteArray());
     setBackupManager(doc);
 
     return doc;
@@ -113,19 +122,31 @@ Document* DocumentBuilder::loadDocument(
 SCORE_LIB_BASE_EXPORT
 Document* DocumentBuilder::restoreDocument(
     const score::GUIApplicationContext& ctx,
-    QString filename,
-    const QByteArray& docData,
-    const QByteArray& cmdData,
+    const RestorableDocument& backup,
     DocumentDelegateFactory& doctype)
 {
   Document* doc = nullptr;
   auto& doclist = ctx.documents.documents();
   try
   {
+    std::vector<score::CommandData> undoStack, redoStack;
+    CommandBackupFile::restore(backup.commands, undoStack, redoStack);
+
     // Restoring behaves just like loading : we reload what was loaded
     // (potentially a blank document which is saved at the beginning, once
-    // every plug-in has been loaded)
-    doc = new Document{filename, docData, doctype, m_parentView, m_parentPresenter};
+    // every plug-in has been loaded), or the latest autosave if it matches
+    // the commands that were backed up.
+    const QByteArray* docData = &backup.doc;
+    int appliedCommands = 0;
+    if (!backup.autosave.isEmpty()
+        && DocumentAutosave::hashCommands(undoStack, redoStack, backup.autosaveIndex)
+               == backup.autosaveCommandsHash)
+    {
+      docData = &backup.autosave;
+      appliedCommands = backup.autosaveIndex;
+    }
+
+    doc = new Document{backup.filePath, *docData, doctype, m_parentView, m_parentPresenter};
     for (auto& appPlug : ctx.guiApplicationPlugins())
     {
       appPlug->on_loadedDocument(*doc);
@@ -139,13 +160,18 @@ Document* DocumentBuilder::restoreDocument(
     doclist.push_back(doc);
 
     // We restore the pre-crash command stack.
-    DataStream::Deserializer writer(cmdData);
-    loadCommandStack(ctx.components, writer, doc->commandStack(), [doc](auto cmd) {
-      cmd->redo(doc->context());
-    });
-
+    loadCommandStack(
+        ctx.components,
+        undoStack,
+        redoStack,
+        appliedCommands,
+        doc->commandStack(),
+        [doc](auto cmd) { cmd->redo(doc->context()); },
+        [doc](auto cmd) { cmd->undo(doc->context()); });
+
+    // The command backup starts from the beginning of the stack
     m_backupManager = new DocumentBackupManager{*doc};
-    m_backupManager->saveModelData(docData); // Reuse the same data
+    m_backupManager->saveModelData(backup.doc); // Reuse the same data
     setBackupManager(doc);
 
     return doc;
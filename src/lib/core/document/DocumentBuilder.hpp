@@ -10,6 +10,7 @@ class Document;
 class DocumentBackupManager;
 class DocumentDelegateFactory;
 class DocumentModel;
+struct RestorableDocument;
 struct GUIApplicationContext;
 
 /**
@@ -36,9 +37,7 @@ public:
       score::DocumentDelegateFactory& doctype);
   Document* restoreDocument(
       const score::GUIApplicationContext& ctx,
-      QString filename,
-      const QByteArray& docData,
-      const QByteArray& cmdData,
+      const RestorableDocument& backup,
       score::DocumentDelegateFactory& doctype);
 
 private:
@@ -0,0 +1,184 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "DocumentContainer.hpp"
+
+#include <QDataStream>
+#include <QObject>
+
+#include <array>
+#include <stdexcept>
+
+namespace score
+{
+namespace
+{
+// "SCB2"
+static constexpr quint32 container_magic = 0x53434232;
+static constexpr quint32 container_version = 1;
+
+static constexpr quint32 header_size = 3 * sizeof(quint32);
+static constexpr quint32 entry_size = 2 * sizeof(quint8) + 2 * sizeof(quint64) + sizeof(quint32);
+
+// Sections smaller than this are not worth compressing
+static constexpr int compression_threshold = 4096;
+
+enum SectionFlags : quint8
+{
+  ZlibCompressed = 1
+};
+
+constexpr std::array<quint32, 256> makeCrcTable() noexcept
+{
+  std::array<quint32, 256> table{};
+  for (quint32 i = 0; i < 256; i++)
+  {
+    quint32 c = i;
+    for (int k = 0; k < 8; k++)
+      c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1);
+    table[i] = c;
+  }
+  return table;
+}
+
+// CRC-32 as in zlib / PNG
+quint32 crc32(const char* data, std::size_t size) noexcept
+{
+  static constexpr auto table = makeCrcTable();
+  quint32 c = 0xFFFFFFFFu;
+  for (std::size_t i = 0; i < size; i++)
+    c = table[(c ^ quint8(data[i])) & 0xFF] ^ (c >> 8);
+  return c ^ 0xFFFFFFFFu;
+}
+
+[[noreturn]] void invalidFile()
+{
+  throw std::runtime_error(QObject::tr("Invalid file.").toStdString());
+}
+}
+
+bool DocumentContainer::isContainer(const QByteArray& data) noexcept
+{
+  if (data.size() < int(header_size))
+    return false;
+
+  QDataStream s{data};
+  quint32 magic{};
+  s >> magic;
+  return magic == container_magic;
+}
+
+QByteArray DocumentContainer::write(
+    const QByteArray& model,
+    const std::vector<QByteArray>& plugins,
+    Compression compression)
+{
+  struct Section
+  {
+    SectionKind kind;
+    quint8 flags;
+    QByteArray data;
+  };
+
+  std::vector<Section> sections;
+  sections.reserve(1 + plugins.size());
+  auto addSection = [&](SectionKind kind, const QByteArray& data) {
+    // Favor speed: the goal is mostly to shrink the large, redundant sections
+    if (compression == Compressed && data.size() > compression_threshold)
+      sections.push_back({kind, ZlibCompressed, qCompress(data, 1)});
+    else
+      sections.push_back({kind, 0, data});
+  };
+
+  addSection(Model, model);
+  for (const auto& plugin : plugins)
+    addSection(Plugin, plugin);
+
+  QByteArray res;
+  quint64 total = header_size + entry_size * sections.size();
+  for (const auto& section : sections)
+    total += section.data.size();
+  res.reserve(int(total));
+
+  QDataStream s{&res, QIODevice::WriteOnly};
+  s << container_magic << container_version << quint32(sections.size());
+
+  quint64 offset = header_size + entry_size * sections.size();
+  for (const auto& section : sections)
+  {
+    const auto& data = section.data;
+    s << quint8(section.kind) << section.flags << offset << quint64(data.size())
+      << crc32(data.constData(), data.size());
+    offset += data.size();
+  }
+
+  for (const auto& section : sections)
+    s.writeRawData(section.data.constData(), section.data.size());
+
+  return res;
+}
+
+DocumentContainer::DocumentContainer(const QByteArray& data)
+    : m_data{data}
+{
+  QDataStream s{data};
+  quint32 magic{}, version{}, count{};
+  s >> magic >> version >> count;
+  if (s.status() != QDataStream::Ok || magic != container_magic)
+    invalidFile();
+
+  if (version > container_version)
+    throw std::runtime_error(
+        QObject::tr("This file was saved with a newer version of score.").toStdString());
+
+  if (quint64(count) * entry_size > quint64(data.size()))
+    invalidFile();
+
+  m_entries.resize(count);
+  for (auto& e : m_entries)
+  {
+    s >> e.kind >> e.flags >> e.offset >> e.size >> e.crc;
+    if (s.status() != QDataStream::Ok || e.offset > quint64(data.size())
+        || e.size > quint64(data.size()) - e.offset)
+      invalidFile();
+  }
+}
+
+int DocumentContainer::sectionCount(SectionKind kind) const noexcept
+{
+  int n = 0;
+  for (const auto& e : m_entries)
+    if (e.kind == kind)
+      n++;
+  return n;
+}
+
+QByteArray DocumentContainer::section(SectionKind kind, int index) const
+{
+  for (const auto& e : m_entries)
+  {
+    if (e.kind != kind)
+      continue;
+
+    if (index-- == 0)
+      return read(e);
+  }
+
+  invalidFile();
+}
+
+QByteArray DocumentContainer::read(const Entry& e) const
+{
+  const char* ptr = m_data.constData() + e.offset;
+  if (crc32(ptr, e.size) != e.crc)
+    invalidFile();
+
+  if (e.flags & ZlibCompressed)
+  {
+    auto res = qUncompress(reinterpret_cast<const uchar*>(ptr), int(e.size));
+    if (res.isEmpty())
+      invalidFile();
+    return res;
+  }
+  return QByteArray{ptr, int(e.size)};
+}
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <QByteArray>
+
+#include <score_lib_base_export.h>
+
+#include <vector>
+
+namespace score
+{
+/**
+ * @brief Binary container used for .scorebin files.
+ *
+ * Layout :
+ * * a header with a magic number and the format version,
+ * * a table of contents, with the kind, position and checksum of each
+ * section,
+ * * the sections: the document model, then each document plug-in.
+ *
+ * Large sections are compressed. Each section is only decompressed and
+ * checked when it is accessed: the whole file does not have to be hashed
+ * before loading, and the sections can be read concurrently, each on the
+ * thread which deserializes it.
+ */
+class SCORE_LIB_BASE_EXPORT DocumentContainer
+{
+public:
+  enum SectionKind : quint8
+  {
+    Model = 0,
+    Plugin = 1
+  };
+
+  enum Compression
+  {
+    Uncompressed,
+    Compressed
+  };
+
+  static bool isContainer(const QByteArray& data) noexcept;
+
+  static QByteArray write(
+      const QByteArray& model,
+      const std::vector<QByteArray>& plugins,
+      Compression compression = Compressed);
+
+  //! Reads the table of contents. Throws if it is invalid.
+  explicit DocumentContainer(const QByteArray& data);
+
+  int sectionCount(SectionKind kind) const noexcept;
+
+  //! Decompresses and checks a section. Throws if it is invalid.
+  QByteArray section(SectionKind kind, int index) const;
+
+private:
+  struct Entry
+  {
+    quint8 kind{};
+    quint8 flags{};
+    quint64 offset{};
+    quint64 size{};
+    quint32 crc{};
+  };
+
+  QByteArray read(const Entry& e) const;
+
+  QByteArray m_data;
+  std::vector<Entry> m_entries;
+};
+}
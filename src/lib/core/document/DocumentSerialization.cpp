@@ -1,6 +1,7 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "Document.hpp"
+#include "DocumentContainer.hpp"
 #include "DocumentModel.hpp"
 
 #include <score/application/ApplicationComponents.hpp>
@@ -36,16 +37,127 @@
 #include <QMetaType>
 #include <QPair>
 #include <QString>
+#include <QThread>
 #include <QVariant>
 #include <QVector>
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <memory>
+#include <optional>
 #include <stdexcept>
 #include <vector>
 
 namespace score
 {
+namespace
+{
+const DocumentPluginFactory*
+pluginFactory(const DocumentPluginFactoryList& factories, const QByteArray& data)
+{
+  try
+  {
+    // Only read the key of the factory, see deserialize_interface
+    DataStream::Deserializer des{data};
+    quint32 size{};
+    des.stream() >> size;
+
+    SCORE_DEBUG_CHECK_DELIMITER2(des);
+    DocumentPluginFactory::ConcreteKey k;
+    TSerializer<DataStream, DocumentPluginFactory::ConcreteKey>::writeTo(des, k);
+    return factories.get(k);
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+
+const DocumentPluginFactory*
+pluginFactory(const DocumentPluginFactoryList& factories, const rapidjson::Value& obj)
+{
+  try
+  {
+    JSONObject::Deserializer des{obj};
+    DocumentPluginFactory::ConcreteKey k;
+    JSONWriter wr{des.obj[des.strings.uuid]};
+    TSerializer<JSONObject, DocumentPluginFactory::ConcreteKey>::writeTo(wr, k);
+    return factories.get(k);
+  }
+  catch (...)
+  {
+    return nullptr;
+  }
+}
+
+/**
+ * Each plug-in is read on a worker thread, e.g. its section of the file is
+ * decompressed there. The plug-ins whose factory allows it are also loaded
+ * there, while the others are loaded on the GUI thread.
+ * They are added to the document in the order in which they were saved.
+ */
+template <typename Read, typename GetFactory, typename LoadPlugin>
+void loadPluginModels(
+    DocumentModel& model,
+    int count,
+    Read read,
+    GetFactory getFactory,
+    LoadPlugin load)
+{
+  using data_type = decltype(read(0));
+  struct Loaded
+  {
+    data_type data{};
+    bool concurrent{};
+    std::unique_ptr<DocumentPlugin> plugin;
+  };
+
+  QThread* const guiThread = model.thread();
+  std::vector<std::future<Loaded>> loading;
+  loading.reserve(count);
+  for (int i = 0; i < count; i++)
+  {
+    loading.push_back(std::async(std::launch::async, [=] {
+      Loaded res;
+      res.data = read(i);
+      auto factory = getFactory(res.data);
+      if (factory && factory->loadsConcurrently())
+      {
+        res.concurrent = true;
+        res.plugin.reset(load(res.data, nullptr));
+        if (res.plugin)
+          res.plugin->moveToThread(guiThread);
+      }
+      return res;
+    }));
+  }
+
+  try
+  {
+    for (auto& f : loading)
+    {
+      Loaded res = f.get();
+      DocumentPlugin* plug = res.concurrent ? res.plugin.release() : load(res.data, &model);
+      if (plug)
+        model.addPluginModel(plug);
+      else
+        SCORE_TODO;
+    }
+  }
+  catch (...)
+  {
+    // The plug-ins which were not added yet are freed with their futures
+    for (auto& f : loading)
+      if (f.valid())
+        f.wait();
+    throw;
+  }
+}
+}
+
 QByteArray Document::saveDocumentModelAsByteArray()
 {
   // TODO refactor this
@@ -101,14 +213,12 @@ void Document::saveAsJson(JSONObject::Serializer& writer)
 QByteArray Document::saveAsByteArray()
 {
   using namespace std;
-  QByteArray global;
-  QDataStream writer(&global, QIODevice::WriteOnly);
 
   // Save the document
   auto docByteArray = saveDocumentModelAsByteArray();
 
   // Save the document plug-ins
-  QVector<QPair<QByteArray, QByteArray>> documentPluginModels;
+  std::vector<QByteArray> documentPluginModels;
 
   for (const auto& plugin : model().pluginModels())
   {
@@ -120,17 +230,14 @@ QByteArray Document::saveAsByteArray()
               serialization_tag<SerializableDocumentPlugin>::type,
               visitor_abstract_object_tag>::value,
           "");
-      QByteArray arr_before, arr_after;
-      DataStream::Serializer s_before{&arr_before};
-      s_before.readFrom(*serializable_plugin);
-      documentPluginModels.push_back({std::move(arr_before), std::move(arr_after)});
+      QByteArray arr;
+      DataStream::Serializer s{&arr};
+      s.readFrom(*serializable_plugin);
+      documentPluginModels.push_back(std::move(arr));
     }
   }
 
-  writer << docByteArray << documentPluginModels;
-
-  auto hash = QCryptographicHash::hash(global, QCryptographicHash::Algorithm::Sha512);
-  writer << hash;
+  auto global = DocumentContainer::write(docByteArray, documentPluginModels);
 
   // Indicate in the stack that the current position is saved
   m_commandStack.markCurrentIndexAsSaved();
@@ -193,7 +300,19 @@ void Document::restoreModel(const QByteArray& data, DocumentDelegateFactory& fac
     appPlug->on_initDocument(*this);
   }
 
-  m_model->loadDocumentAsByteArray(m_context, data, factory);
+  // The backup may be a copy of the .score file the document was loaded from
+  auto first = std::find_if_not(
+      data.begin(), data.end(), [](char c) { return std::isspace((unsigned char)c); });
+  if (first != data.end() && *first == '{')
+  {
+    auto doc = readJson(data);
+    DocumentManager::checkAndUpdateJson(doc, m_context.app);
+    m_model->loadDocumentAsJson(m_context, doc, factory);
+  }
+  else
+  {
+    m_model->loadDocumentAsByteArray(m_context, data, factory);
+  }
 }
 
 void Document::loadModel(const QString& fileName, DocumentDelegateFactory& factory)
@@ -223,7 +342,8 @@ void Document::loadModel(const QString& fileName, DocumentDelegateFactory& facto
     auto data = f.readAll();
     SCORE_ASSERT(!data.isEmpty());
 
-    auto doc = readJson(data);
+    // data has to stay alive until the document is loaded
+    auto doc = readJsonInSitu(data);
     bool ok = DocumentManager::checkAndUpdateJson(doc, m_context.app);
     if (!ok)
     {
@@ -257,25 +377,41 @@ void DocumentModel::loadDocumentAsByteArray(
     DocumentDelegateFactory& fact)
 {
   // Deserialize the first parts
+  std::optional<DocumentContainer> container;
+  std::future<QByteArray> containerModel;
   QByteArray doc;
   QVector<QPair<QByteArray, QByteArray>> documentPluginModels;
-  QByteArray hash;
+  int plug_n = 0;
 
-  QDataStream wr{data};
-  wr >> doc >> documentPluginModels >> hash;
-
-  // Perform hash verification
-  QByteArray verif_arr;
-  QDataStream writer(&verif_arr, QIODevice::WriteOnly);
-  writer << doc << documentPluginModels;
-  if (QCryptographicHash::hash(verif_arr, QCryptographicHash::Algorithm::Sha512) != hash)
+  if (DocumentContainer::isContainer(data))
   {
-    throw std::runtime_error("Invalid file.");
+    // Each section is decompressed and checked on a worker thread, when it is read
+    container.emplace(data);
+    containerModel = std::async(std::launch::async, [&] {
+      return container->section(DocumentContainer::Model, 0);
+    });
+    plug_n = container->sectionCount(DocumentContainer::Plugin);
   }
+  else
+  {
+    // Files saved before the container format
+    QByteArray hash;
 
-  // Set the id
+    QDataStream wr{data};
+    wr >> doc >> documentPluginModels >> hash;
 
-  DataStream::Deserializer doc_writer{doc};
+    // Perform hash verification
+    QByteArray verif_arr;
+    QDataStream writer(&verif_arr, QIODevice::WriteOnly);
+    writer << doc << documentPluginModels;
+    if (QCryptographicHash::hash(verif_arr, QCryptographicHash::Algorithm::Sha512) != hash)
+    {
+      throw std::runtime_error("Invalid file.");
+    }
+    plug_n = documentPluginModels.size();
+  }
+
+  // Set the id
   this->setId(getStrongId(ctx.app.documents.documents()));
 
   // Note : this *has* to be in this order, because
@@ -283,29 +419,23 @@ void DocumentModel::loadDocumentAsByteArray(
   // document that requires the plugin models to be loaded
   // in order to be deserialized. (e.g. the groups for the network)
   // First load the plugin models
-
-  const auto plug_n = documentPluginModels.size();
-
   auto& plugin_factories = ctx.app.interfaces<DocumentPluginFactoryList>();
-  std::vector<score::DocumentPlugin*> docs(plug_n, nullptr);
-
-  for (int i = 0; i < plug_n; i++)
-  {
-    const auto& plugin_raw = documentPluginModels[i];
-
-    DataStream::Deserializer plug_writer{plugin_raw.first};
-    auto plug = deserialize_interface(plugin_factories, plug_writer, ctx, this);
-
-    docs[i] = plug;
-    if (plug)
-    {
-      this->addPluginModel(plug);
-    }
-    else
-    {
-      SCORE_TODO;
-    }
-  }
+  loadPluginModels(
+      *this,
+      plug_n,
+      [&](int i) {
+        return container ? container->section(DocumentContainer::Plugin, i)
+                         : documentPluginModels.at(i).first;
+      },
+      [&](const QByteArray& plugin) { return pluginFactory(plugin_factories, plugin); },
+      [&](const QByteArray& plugin, QObject* parent) {
+        DataStream::Deserializer plug_writer{plugin};
+        return deserialize_interface(plugin_factories, plug_writer, ctx, parent);
+      });
+
+  if (container)
+    doc = containerModel.get();
+  DataStream::Deserializer doc_writer{doc};
 
   // Load the document model
   fact.load(doc_writer.toVariant(), ctx, m_model, this);
@@ -324,22 +454,17 @@ void DocumentModel::loadDocumentAsJson(
   this->setId(getStrongId(ctx.app.documents.documents()));
 
   // Load the plug-in models
-  auto json_plugins = json["Plugins"].GetArray();
+  const auto& json_plugins = json["Plugins"].GetArray();
   auto& plugin_factories = ctx.app.interfaces<DocumentPluginFactoryList>();
-  for (const auto& plugin : json_plugins)
-  {
-    JSONObject::Deserializer plug_writer{plugin};
-    auto plug = deserialize_interface(plugin_factories, plug_writer, ctx, this);
-
-    if (plug)
-    {
-      this->addPluginModel(plug);
-    }
-    else
-    {
-      SCORE_TODO;
-    }
-  }
+  loadPluginModels(
+      *this,
+      json_plugins.Size(),
+      [&](int i) { return &json_plugins[i]; },
+      [&](const rapidjson::Value* plugin) { return pluginFactory(plugin_factories, *plugin); },
+      [&](const rapidjson::Value* plugin, QObject* parent) {
+        JSONObject::Deserializer plug_writer{*plugin};
+        return deserialize_interface(plugin_factories, plug_writer, ctx, parent);
+      });
 
   // Load the model
   JSONObject::Deserializer doc_writer{doc};
@@ -621,12 +621,7 @@ void DocumentManager::restoreDocuments(const score::GUIApplicationContext& ctx)
 {
   for (const RestorableDocument& backup : DocumentBackups::restorableDocuments())
   {
-    restoreDocument(
-        ctx,
-        backup.filePath,
-        backup.doc,
-        backup.commands,
-        *ctx.interfaces<DocumentDelegateList>().begin());
+    restoreDocument(ctx, backup, *ctx.interfaces<DocumentDelegateList>().begin());
   }
 }
 
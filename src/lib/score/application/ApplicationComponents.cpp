@@ -79,4 +79,12 @@ Command* ApplicationComponents::instantiateUndoCommand(const CommandData& cmd) c
 #endif
   return nullptr;
 }
+
+bool ApplicationComponents::hasUndoCommand(
+    const CommandGroupKey& parent,
+    const CommandKey& cmd) const noexcept
+{
+  auto it = m_data.commands.find(parent);
+  return it != m_data.commands.end() && it->second.find(cmd) != it->second.end();
+}
 }
@@ -169,6 +169,9 @@ public:
 
   score::Command* instantiateUndoCommand(const CommandData& cmd) const;
 
+  //! True if instantiateUndoCommand is able to create this command
+  bool hasUndoCommand(const CommandGroupKey& parent, const CommandKey& cmd) const noexcept;
+
 private:
   const score::ApplicationComponentsData& m_data;
 };
@@ -29,6 +29,7 @@ class EntityMapInserter<score::Entity<T>>
     auto new_name = ossia::net::sanitize_name(obj->metadata().getName(), bros_names);
     obj->metadata().setName(new_name);
 
+    obj->updateIndex();
     map.unsafe_map().insert(obj);
 
     map.mutable_added(*obj);
@@ -25,6 +25,7 @@ public:
  * Differences :
  *  - Deletes objects when they are removed ("ownership")
  *  - Sends signals after adding and before deleting.
+ *  - Keeps the objects in the index used by ObjectPath up-to-date.
  *
  * Tthe parent of the childs are the parents of the map.
  * Hence the objects shall not be deleted upon deletion of the map
@@ -111,6 +112,8 @@ template <typename T>
 void EntityMapInserter<T>::add(EntityMap<T>& map, T* t)
 {
   SCORE_ASSERT(t);
+  // The object may have been reparented since it was created
+  t->updateIndex();
   map.unsafe_map().insert(t);
 
   map.mutable_added(*t);
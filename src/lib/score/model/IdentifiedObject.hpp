@@ -27,8 +27,10 @@ public:
       : IdentifiedObjectAbstract{name, parent}, m_id{std::move(id)}
   {
     m_id.m_ptr = this;
+    updateIndex();
   }
 
+  // The identifier is set by the visitor, which indexes the object
   template <typename Visitor>
   IdentifiedObject(Visitor&& v, QObject* parent) noexcept : IdentifiedObjectAbstract{parent}
   {
@@ -48,6 +50,7 @@ public:
     m_id = id;
     m_path_cache.unsafePath().vec().clear();
     m_id.m_ptr = this;
+    updateIndex();
   }
 
   void setId(id_type&& id) noexcept
@@ -55,6 +58,7 @@ public:
     m_id = std::move(id);
     m_path_cache.unsafePath().vec().clear();
     m_id.m_ptr = this;
+    updateIndex();
   }
 
   void resetCache() const noexcept override { m_path_cache.unsafePath().vec().clear(); }
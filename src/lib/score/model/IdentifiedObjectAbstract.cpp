@@ -4,9 +4,122 @@
 
 #include <score/tools/std/HashMap.hpp>
 
+#include <QHash>
+
+#include <functional>
+#include <mutex>
+
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(IdentifiedObjectAbstract)
+namespace
+{
+struct IndexKey
+{
+  const QObject* parent{};
+  QString name;
+  int32_t id{};
+
+  bool operator==(const IndexKey& other) const noexcept
+  {
+    return parent == other.parent && id == other.id && score::sameString(name, other.name);
+  }
+};
+
+struct IndexKeyHash
+{
+  std::size_t operator()(const IndexKey& k) const noexcept
+  {
+    std::size_t seed = std::hash<const void*>{}(k.parent);
+    seed ^= qHash(k.name) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<int32_t>{}(k.id) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+  }
+};
+
+// (parent, object name, id) -> object, for all the identified objects which
+// have a parent, i.e. all the objects of the documents.
+// Model objects are only created on the GUI thread, but documents
+// plug-ins may be loaded in other threads.
+struct ObjectIndex
+{
+  std::mutex mutex;
+  score::hash_map<IndexKey, IdentifiedObjectAbstract*, IndexKeyHash> map;
+
+  void remove(const IndexKey& k, const IdentifiedObjectAbstract* obj) noexcept
+  {
+    auto it = map.find(k);
+    // Another object may have been indexed with the same key since
+    if (it != map.end() && it->second == obj)
+      map.erase(it);
+  }
+};
+
+ObjectIndex& objectIndex() noexcept
+{
+  // Leaked on purpose so that objects destroyed late do not outlive it
+  static auto& index = *new ObjectIndex;
+  return index;
+}
+}
+
 IdentifiedObjectAbstract::~IdentifiedObjectAbstract()
 {
+  if (m_indexParent)
+  {
+    auto& index = objectIndex();
+    std::lock_guard lck{index.mutex};
+    index.remove({m_indexParent, m_indexName, m_indexId}, this);
+  }
+
   identified_object_destroyed(this);
 }
+
+IdentifiedObjectAbstract* IdentifiedObjectAbstract::findIndexedChild(
+    const QObject* parent,
+    const QString& name,
+    int32_t id) noexcept
+{
+  auto& index = objectIndex();
+  IdentifiedObjectAbstract* obj{};
+  {
+    std::lock_guard lck{index.mutex};
+    auto it = index.map.find({parent, name, id});
+    if (it == index.map.end())
+      return nullptr;
+    obj = it->second;
+  }
+
+  // QObject::setParent and setObjectName are not virtual: check that the
+  // entry is still accurate. The id is always accurate since setId reindexes.
+  if (obj->parent() != parent || !score::sameString(obj->objectName(), name))
+    return nullptr;
+  return obj;
+}
+
+void IdentifiedObjectAbstract::updateIndex() noexcept
+{
+  IndexKey key{parent(), objectName(), id_val()};
+
+  auto& index = objectIndex();
+  std::lock_guard lck{index.mutex};
+  if (m_indexParent)
+    index.remove({m_indexParent, m_indexName, m_indexId}, this);
+
+  if (key.parent)
+  {
+    // Temporary copies of an object are sometimes created with the same
+    // parent and id, e.g. when pasting: like a search in
+    // QObject::children(), keep finding the object which was there first.
+    auto [it, inserted] = index.map.try_emplace(key, this);
+    if (!inserted)
+    {
+      auto other = it->second;
+      if (other->parent() != key.parent || !score::sameString(other->objectName(), key.name))
+        it.value() = this;
+    }
+  }
+
+  m_indexParent = key.parent;
+  m_indexName = std::move(key.name);
+  m_indexId = key.id;
+}
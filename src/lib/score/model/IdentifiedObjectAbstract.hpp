@@ -1,4 +1,6 @@
 #pragma once
+#include <score/tools/InternedString.hpp>
+
 #include <QObject>
 
 #include <score_lib_base_export.h>
@@ -29,13 +31,34 @@ public:
 
   virtual void resetCache() const noexcept = 0;
 
+  /**
+   * @brief Finds a child of an object by name and identifier.
+   *
+   * Constant-time lookup used by ObjectPath instead of iterating over
+   * QObject::children().
+   * Returns nullptr if the object is not indexed, e.g. if it was
+   * reparented or renamed since it was indexed: callers must then fall back
+   * to a linear search, and call updateIndex() on the result.
+   */
+  static IdentifiedObjectAbstract*
+  findIndexedChild(const QObject* parent, const QString& name, int32_t id) noexcept;
+
+  //! Indexes the object with its current parent, name and identifier.
+  void updateIndex() noexcept;
+
 protected:
   using QObject::QObject;
   IdentifiedObjectAbstract(const QString& name, QObject* parent) noexcept
   {
-    QObject::setObjectName(name);
+    QObject::setObjectName(score::intern(name));
     QObject::setParent(parent);
   }
+
+private:
+  // Key under which the object is currently indexed
+  const QObject* m_indexParent{};
+  QString m_indexName;
+  int32_t m_indexId{};
 };
 
 W_REGISTER_ARGTYPE(IdentifiedObjectAbstract*)
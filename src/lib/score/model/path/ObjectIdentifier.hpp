@@ -1,6 +1,7 @@
 #pragma once
 #include <score/model/Identifier.hpp>
 #include <score/serialization/VisitorInterface.hpp>
+#include <score/tools/InternedString.hpp>
 
 #include <ossia/detail/config.hpp>
 
@@ -21,7 +22,7 @@ class ObjectIdentifier
 {
   friend bool operator==(const ObjectIdentifier& lhs, const ObjectIdentifier& rhs)
   {
-    return (lhs.m_objectName == rhs.m_objectName) && (lhs.m_id == rhs.m_id);
+    return (lhs.m_id == rhs.m_id) && score::sameString(lhs.m_objectName, rhs.m_objectName);
   }
 
 public:
@@ -22,7 +22,7 @@ void DataStreamWriter::write(ObjectIdentifier& obj)
   QString name;
   int32_t id;
   m_stream >> name >> id;
-  obj = ObjectIdentifier{name, id};
+  obj = ObjectIdentifier{score::intern(name), id};
 }
 
 template <>
@@ -37,5 +37,6 @@ void JSONReader::read(const ObjectIdentifier& id)
 template <>
 void JSONWriter::write(ObjectIdentifier& id)
 {
-  id = ObjectIdentifier{obj[strings.ObjectName].toString(), obj[strings.ObjectId].toInt()};
+  id = ObjectIdentifier{
+      score::intern(obj[strings.ObjectName].toString()), obj[strings.ObjectId].toInt()};
 }
@@ -149,38 +149,44 @@ QString ObjectPath::toString() const noexcept
   return s;
 }
 
-QObject* ObjectPath::find_impl(const score::DocumentContext& ctx) const
+namespace
 {
-  using namespace score;
-  QObject* obj = &ctx.document.model();
-  SCORE_ASSERT(obj);
+QObject* findChild(QObject* obj, const ObjectIdentifier& identifier) noexcept
+{
+  if (auto found
+      = IdentifiedObjectAbstract::findIndexedChild(obj, identifier.objectName(), identifier.id()))
+    return found;
 
-  for (const auto& currentObjIdentifier : m_objectIdentifiers)
+  // Not indexed, or reparented / renamed since: look for it and reindex it
+  const QObjectList& children = obj->children();
+  for (int i = 0; i < children.size(); ++i)
   {
-    const QObjectList& children = obj->children();
-    QObject* found = nullptr;
-
-    for (int i = 0; i < children.size(); ++i)
+    auto child = children.at(i);
+    SCORE_ASSERT(child);
+    if (score::sameString(child->objectName(), identifier.objectName()))
     {
-      obj = children.at(i);
-      SCORE_ASSERT(obj);
-      if (obj->objectName() == currentObjIdentifier.objectName())
+      auto itf = safe_cast<IdentifiedObjectAbstract*>(child);
+      if (itf->id_val() == identifier.id())
       {
-        auto itf = safe_cast<IdentifiedObjectAbstract*>(obj);
-        if (itf->id_val() == currentObjIdentifier.id())
-        {
-          found = itf;
-          break;
-        }
+        itf->updateIndex();
+        return itf;
       }
     }
+  }
+  return nullptr;
+}
+}
 
-    if (found)
-    {
-      obj = found;
-      SCORE_ASSERT(obj);
-    }
-    else
+QObject* ObjectPath::find_impl(const score::DocumentContext& ctx) const
+{
+  using namespace score;
+  QObject* obj = &ctx.document.model();
+  SCORE_ASSERT(obj);
+
+  for (const auto& currentObjIdentifier : m_objectIdentifiers)
+  {
+    obj = findChild(obj, currentObjIdentifier);
+    if (!obj)
     {
       SCORE_BREAKPOINT;
       throw std::runtime_error(QString("findById : id %1 not found")
@@ -201,31 +207,9 @@ QObject* ObjectPath::find_impl_unsafe(const score::DocumentContext& ctx) const n
 
   for (const auto& currentObjIdentifier : m_objectIdentifiers)
   {
-    const QObjectList& children = obj->children();
-    QObject* found = nullptr;
-
-    for (int i = 0; i < children.size(); ++i)
-    {
-      obj = children.at(i);
-      if (obj->objectName() == currentObjIdentifier.objectName())
-      {
-        auto itf = safe_cast<IdentifiedObjectAbstract*>(obj);
-        if (itf->id_val() == currentObjIdentifier.id())
-        {
-          found = itf;
-          break;
-        }
-      }
-    }
-
-    if (found)
-    {
-      obj = found;
-    }
-    else
-    {
+    obj = findChild(obj, currentObjIdentifier);
+    if (!obj)
       return nullptr;
-    }
   }
 
   return obj;
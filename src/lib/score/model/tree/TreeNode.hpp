@@ -3,6 +3,7 @@
 
 #include <ossia/detail/algorithms.hpp>
 
+#include <cstdint>
 #include <list>
 #include <vector>
 
@@ -52,6 +53,7 @@ class TreeNode : public DataType
 private:
   TreeNode* m_parent{};
   std::list<TreeNode> m_children;
+  uint32_t m_generation{};
   using impl_type = std::list<TreeNode>;
 
 public:
@@ -93,6 +95,7 @@ public:
     m_parent = source.m_parent;
 
     m_children = source.m_children;
+    m_generation++;
     for (auto& child : m_children)
     {
       child.setParent(this);
@@ -107,6 +110,7 @@ public:
     m_parent = source.m_parent;
 
     m_children = std::move(source.m_children);
+    m_generation++;
     for (auto& child : m_children)
     {
       child.setParent(this);
@@ -155,6 +159,7 @@ public:
   auto& emplace(Args&&... args) noexcept
   {
     auto& n = *m_children.emplace(std::forward<Args>(args)...);
+    m_generation++;
     n.setParent(this);
     return n;
   }
@@ -193,15 +198,36 @@ public:
   {
     // m_children.reserve(s);
   }
-  void resize(std::size_t s) noexcept { m_children.resize(s); }
+  void resize(std::size_t s) noexcept
+  {
+    m_children.resize(s);
+    m_generation++;
+  }
 
-  auto erase(const_iterator it) noexcept { return m_children.erase(it); }
+  auto erase(const_iterator it) noexcept
+  {
+    m_generation++;
+    return m_children.erase(it);
+  }
 
   auto erase(const_iterator it_beg, const_iterator it_end) noexcept
   {
+    m_generation++;
     return m_children.erase(it_beg, it_end);
   }
 
+  /**
+   * @brief Changes each time children are removed, replaced, or inserted
+   * anywhere but at the end.
+   *
+   * Used to invalidate the indexes built over the children, see e.g.
+   * Device::findChild: appended children can just be added to them.
+   * When a child is modified in a way that affects such an index,
+   * e.g. renamed, childrenChanged must be called.
+   */
+  uint32_t generation() const noexcept { return m_generation; }
+  void childrenChanged() noexcept { m_generation++; }
+
   void setParent(TreeNode* parent) noexcept { m_parent = parent; }
 
   template <typename Fun>
@@ -55,6 +55,9 @@ class ProjectSettingsDelegateFactory_T : public ProjectSettingsFactory
     });
   }
 
+  // Project settings only read their own values when loaded
+  bool loadsConcurrently() const noexcept override { return true; }
+
   ProjectSettingsModel* makeModel(
       const score::DocumentContext& ctx,
       Id<score::DocumentPlugin> id,
@@ -30,6 +30,19 @@ public:
   virtual DocumentPlugin*
   load(const VisitorVariant& var, score::DocumentContext& doc, QObject* parent)
       = 0;
+
+  /**
+   * @brief Whether load can be called outside of the GUI thread.
+   *
+   * In this case, when a document is loaded, load is called on a worker
+   * thread with a null parent, in parallel with the other plug-ins ;
+   * the plug-in is then moved to the GUI thread and added to the document.
+   *
+   * Only reimplement if loading the plug-in solely reads its own
+   * serialized data, without accessing the rest of the document or
+   * GUI-thread objects.
+   */
+  virtual bool loadsConcurrently() const noexcept { return false; }
 };
 class SCORE_LIB_BASE_EXPORT DocumentPluginFactoryList final
     : public score::InterfaceList<score::DocumentPluginFactory>
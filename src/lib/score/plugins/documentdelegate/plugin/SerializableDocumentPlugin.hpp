@@ -1,8 +1,12 @@
 #pragma once
+#include <score/command/CommandFactoryKey.hpp>
+#include <score/plugins/StringFactoryKey.hpp>
 #include <score/plugins/documentdelegate/plugin/DocumentPluginBase.hpp>
 
 #include <verdigris>
 
+#include <optional>
+
 namespace score
 {
 class DocumentPluginFactory;
@@ -28,6 +32,15 @@ class SCORE_LIB_BASE_EXPORT SerializableDocumentPlugin
 {
   W_OBJECT(SerializableDocumentPlugin)
 public:
+  /**
+   * @brief The group of the commands which modify this plug-in.
+   *
+   * To be set if the plug-in is only modified by the commands of a group,
+   * and if these commands modify nothing else. The autosave then only
+   * serializes the plug-in again after such commands.
+   */
+  virtual std::optional<CommandGroupKey> commandGroup() const { return std::nullopt; }
+
 protected:
   using DocumentPlugin::DocumentPlugin;
   using ConcreteKey = UuidKey<DocumentPluginFactory>;
@@ -4,6 +4,7 @@
 #include <score/serialization/CommonTypes.hpp>
 #include <score/serialization/VisitorInterface.hpp>
 #include <score/serialization/VisitorTags.hpp>
+#include <score/tools/InternedString.hpp>
 #include <score/tools/std/HashMap.hpp>
 #include <score/tools/std/Optional.hpp>
 
@@ -480,7 +481,7 @@ struct TSerializer<DataStream, IdentifiedObject<T>>
     SCORE_DEBUG_CHECK_DELIMITER2(s);
     s.stream() >> name;
     SCORE_DEBUG_CHECK_DELIMITER2(s);
-    obj.setObjectName(name);
+    obj.setObjectName(score::intern(name));
     s.writeTo(id);
     obj.setId(std::move(id));
     SCORE_DEBUG_CHECK_DELIMITER2(s);
@@ -5,6 +5,7 @@
 #include <score/serialization/VisitorInterface.hpp>
 #include <score/serialization/VisitorTags.hpp>
 #include <score/tools/ForEach.hpp>
+#include <score/tools/InternedString.hpp>
 
 #include <ossia/detail/flat_set.hpp>
 #include <ossia/detail/json.hpp>
@@ -332,8 +333,23 @@ inline JSONReader::assigner JSONReader::fake_obj::operator[](std::string_view st
 }
 inline JSONReader::assigner JSONReader::fake_obj::operator[](const QString& str) const noexcept
 {
-  const std::string& s = str.toStdString();
-  self.stream.Key(s.data(), s.length());
+  // Keys are almost always ASCII: convert them without allocating
+  thread_local std::string key;
+  const int n = str.size();
+  const QChar* data = str.constData();
+  key.resize(n);
+  for (int i = 0; i < n; i++)
+  {
+    const ushort c = data[i].unicode();
+    if (c >= 0x80)
+    {
+      key = str.toStdString();
+      break;
+    }
+    key[i] = char(c);
+  }
+
+  self.stream.Key(key.data(), key.length());
   return assigner{self};
 }
 template <std::size_t N>
@@ -540,7 +556,7 @@ struct TSerializer<JSONObject, IdentifiedObject<T>>
   template <typename U>
   static void writeTo(JSONObject::Deserializer& s, IdentifiedObject<U>& obj)
   {
-    obj.setObjectName(s.obj[s.strings.ObjectName].toString());
+    obj.setObjectName(score::intern(s.obj[s.strings.ObjectName].toString()));
     obj.setId(Id<T>{s.obj[s.strings.id].toInt()});
   }
 };
@@ -1286,6 +1302,24 @@ inline rapidjson::Document readJson(const QByteArray& arr)
   return doc;
 }
 
+/**
+ * @brief Parses a JSON document in place.
+ *
+ * Strings are not copied in the document but point into arr, which is
+ * modified and must outlive the document: for large files this saves
+ * the memory and the time of copying every string.
+ */
+inline rapidjson::Document readJsonInSitu(QByteArray& arr)
+{
+  rapidjson::Document doc;
+  doc.ParseInsitu(arr.data());
+  if (doc.HasParseError())
+  {
+    qDebug() << "Invalid JSON document !";
+  }
+  return doc;
+}
+
 inline QByteArray jsonToByteArray(const rapidjson::Value& arr) noexcept
 {
   rapidjson::StringBuffer buf;
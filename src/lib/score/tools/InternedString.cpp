@@ -0,0 +1,59 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "InternedString.hpp"
+
+#include <QSet>
+
+#include <algorithm>
+#include <mutex>
+
+namespace score
+{
+namespace
+{
+struct InternTable
+{
+  std::mutex mutex;
+  QSet<QString> strings;
+  int collectAt{4096};
+
+  // Drops the strings which are only referenced by the table anymore
+  void collect()
+  {
+    for (auto it = strings.begin(); it != strings.end();)
+    {
+      if (it->isDetached())
+        it = strings.erase(it);
+      else
+        ++it;
+    }
+    collectAt = std::max(4096, 2 * int(strings.size()));
+  }
+};
+
+InternTable& internTable() noexcept
+{
+  static auto& table = *new InternTable;
+  return table;
+}
+}
+
+QString intern(const QString& str)
+{
+  if (str.isEmpty())
+    return str;
+
+  auto& table = internTable();
+  std::lock_guard lck{table.mutex};
+  if (auto it = table.strings.constFind(str); it != table.strings.cend())
+    return *it;
+
+  if (table.strings.size() >= table.collectAt)
+    table.collect();
+
+  // Deep copy, in case str points to raw data (QString::fromRawData)
+  QString copy{str.constData(), str.size()};
+  table.strings.insert(copy);
+  return copy;
+}
+}
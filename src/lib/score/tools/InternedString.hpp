@@ -0,0 +1,26 @@
+#pragma once
+#include <QString>
+
+#include <score_lib_base_export.h>
+
+namespace score
+{
+/**
+ * @brief Interns a string in a global table.
+ *
+ * Returns a string equal to str, which shares its data with all the other
+ * interned strings equal to it: documents with many objects or addresses
+ * with the same names only store each name once, and interned strings
+ * compare in constant time with sameString.
+ *
+ * Used for object names and address components when deserializing.
+ * Thread-safe.
+ */
+SCORE_LIB_BASE_EXPORT QString intern(const QString& str);
+
+//! String equality, in constant time when both strings are interned.
+inline bool sameString(const QString& lhs, const QString& rhs) noexcept
+{
+  return (lhs.constData() == rhs.constData() && lhs.size() == rhs.size()) || lhs == rhs;
+}
+}
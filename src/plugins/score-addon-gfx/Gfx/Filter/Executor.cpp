@@ -23,7 +23,7 @@ public:
   {
     auto n = std::make_unique<FilterNode>(frag);
 
-    id = exec_context->ui->register_node(std::move(n));
+    register_node(std::move(n));
   }
 
   filter_node(const isf::descriptor& isf, const QString& frag, GfxExecutionAction& ctx)
@@ -31,7 +31,7 @@ public:
   {
     auto n = std::make_unique<ISFNode>(isf, frag);
 
-    id = exec_context->ui->register_node(std::move(n));
+    register_node(std::move(n));
   }
 
   ~filter_node() { exec_context->ui->unregister_node(id); }
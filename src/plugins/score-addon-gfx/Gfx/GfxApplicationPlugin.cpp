@@ -1,5 +1,6 @@
 #include "GfxApplicationPlugin.hpp"
 
+#include <score/tools/Bind.hpp>
 #include <score/tools/IdentifierGeneration.hpp>
 
 #include <core/application/ApplicationSettings.hpp>
@@ -7,6 +8,7 @@
 #include <core/document/DocumentModel.hpp>
 
 #include <Execution/DocumentPlugin.hpp>
+#include <Execution/Settings/ExecutorModel.hpp>
 
 #include <Gfx/GfxParameter.hpp>
 #include <Gfx/CameraDevice.hpp>
@@ -21,8 +23,10 @@ gfx_exec_node::~gfx_exec_node()
 }
 
 
-void gfx_exec_node::run(const ossia::token_request& tk, ossia::exec_state_facade) noexcept
+void gfx_exec_node::run(const ossia::token_request& tk, ossia::exec_state_facade e) noexcept
 {
+  exec_context->nodeExecuted(e.sampleRate());
+
   {
     // Copy all the UI controls
     const int n = controls.size();
@@ -36,11 +40,12 @@ void gfx_exec_node::run(const ossia::token_request& tk, ossia::exec_state_facade
       }
     }
   }
-  gfx_message msg;
-  msg.node_id = id;
-  msg.token = tk;
+  if (!slots)
+    return;
+
+  slots->token.back() = tk;
+  slots->token.publish();
 
-  msg.inputs.resize(this->m_inlets.size());
   int inlet_i = 0;
   for (ossia::inlet* inlet : this->m_inlets)
   {
@@ -66,10 +71,10 @@ void gfx_exec_node::run(const ossia::token_request& tk, ossia::exec_state_facade
     {
       auto& p = inlet->cast<ossia::value_port>();
 
-      for (ossia::timed_value& val : p.get_data())
-      {
-        msg.inputs[inlet_i].push_back(std::move(val.value));
-      }
+      // Only the latest value of the tick is relevant to the renderer
+      auto& data = p.get_data();
+      if (!data.empty())
+        slots->write(inlet_i, std::move(data.back().value));
       break;
     }
     case ossia::texture_port::which:
@@ -89,7 +94,7 @@ void gfx_exec_node::run(const ossia::token_request& tk, ossia::exec_state_facade
     case ossia::audio_port::which:
     {
       auto& p = inlet->cast<ossia::audio_port>();
-      msg.inputs[inlet_i].push_back(std::move(p.samples));
+      slots->write(inlet_i, p.samples);
       break;
     }
     }
@@ -105,8 +110,6 @@ void gfx_exec_node::run(const ossia::token_request& tk, ossia::exec_state_facade
       p->push_texture({this->id, 0});
     }
   }
-
-  exec_context->ui->tick_messages.enqueue(std::move(msg));
 }
 
 
@@ -118,6 +121,14 @@ DocumentPlugin::DocumentPlugin(
 {
   auto& exec_plug = ctx.plugin<Execution::DocumentPlugin>();
   exec_plug.registerAction(exec);
+
+  auto& settings = ctx.app.settings<Execution::Settings::Model>();
+  auto updateClock = [this, &settings] {
+    auto clock = settings.clockFactories().get(settings.getClock());
+    exec.setRealTime(!clock || clock->realTime());
+  };
+  updateClock();
+  con(settings, &Execution::Settings::Model::ClockChanged, this, updateClock);
 }
 
 DocumentPlugin::~DocumentPlugin() { }
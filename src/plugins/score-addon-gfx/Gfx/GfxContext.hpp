@@ -5,8 +5,13 @@
 #include <ossia/detail/hash_map.hpp>
 #include <ossia/network/value/value_conversion.hpp>
 
+#include <Gfx/GfxInputSlots.hpp>
 #include <Gfx/Graph/graph.hpp>
-#include <concurrentqueue.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
 namespace Gfx
 {
 
@@ -29,18 +34,10 @@ struct port_index
   }
 };
 
-using gfx_input = std::variant<ossia::value, ossia::audio_vector>;
-
-struct gfx_message
-{
-  int32_t node_id{};
-  ossia::token_request token{};
-  std::vector<std::vector<gfx_input>> inputs;
-};
-
 struct gfx_view_node
 {
   std::unique_ptr<NodeModel> impl;
+  std::unique_ptr<gfx_node_slots> slots;
 
   void process(const ossia::token_request& tk)
   {
@@ -214,6 +211,7 @@ struct gfx_view_node
         }
       }
     }
+    impl->materialChanged++;
   }
 };
 
@@ -231,8 +229,6 @@ class gfx_window_context : public QObject
   bool must_recompute = false;
 
 public:
-  moodycamel::ConcurrentQueue<gfx_message> tick_messages;
-
   gfx_window_context()
   {
 #if defined(Q_OS_WIN)
@@ -269,7 +265,8 @@ public:
   {
     auto next = index;
     m_graph->addNode(node.get());
-    nodes[next] = {std::move(node)};
+    auto slots = std::make_unique<gfx_node_slots>(*node);
+    nodes[next] = {std::move(node), std::move(slots)};
 
     index++;
 
@@ -277,6 +274,14 @@ public:
     return next;
   }
 
+  //! The returned table lives until unregister_node is called for that node
+  gfx_node_slots* input_slots(int32_t idx) const noexcept
+  {
+    if (auto it = nodes.find(idx); it != nodes.end())
+      return it->second.slots.get();
+    return nullptr;
+  }
+
   void unregister_node(int32_t idx)
   {
     // Remove all edges involving that node
@@ -327,6 +332,7 @@ public:
   {
     recompute_edges();
     m_graph->setupOutputs(m_api);
+    next_offline_frame.store(m_graph->renderUntil(-1.), std::memory_order_release);
     must_recompute = false;
   }
 
@@ -341,44 +347,31 @@ public:
   {
     struct node_vis
     {
-      gfx_window_context& self;
       gfx_view_node& node;
-      port_index sink{};
+      int32_t port{};
 
-      void operator()(ossia::value&& v) const noexcept { node.process(sink.port, std::move(v)); }
-
-      void operator()(ossia::audio_vector&& v) const noexcept
-      {
-        node.process(sink.port, std::move(v));
-      }
+      void operator()(const ossia::value& v) const noexcept { node.process(port, v); }
+      void operator()(const ossia::audio_vector& v) const noexcept { node.process(port, v); }
     };
 
-    gfx_message msg;
-    while (tick_messages.try_dequeue(msg))
+    for (auto& [id, node] : nodes)
     {
-      if (auto it = nodes.find(msg.node_id); it != nodes.end())
-      {
-        auto& node = it->second;
-        node.process(msg.token);
-
-        node_vis v{*this, node};
-        int32_t p = 0;
-        for (std::vector<gfx_input>& dat : msg.inputs)
-        {
-          v.sink = port_index{msg.node_id, p};
-          for (gfx_input& m : dat)
-            std::visit(v, std::move(m));
+      gfx_node_slots& slots = *node.slots;
+      if (slots.token.fetch())
+        node.process(slots.token.front());
 
-          p++;
-        }
+      const int32_t n = slots.input_count;
+      for (int32_t p = 0; p < n; p++)
+      {
+        auto& slot = slots.inputs[p];
+        if (slot.fetch())
+          std::visit(node_vis{node, p}, slot.front());
       }
     }
   }
 
-  void timerEvent(QTimerEvent*) override
+  void update_edges()
   {
-    update_inputs();
-
     if (edges_changed)
     {
       {
@@ -390,10 +383,63 @@ public:
     }
   }
 
+  void timerEvent(QTimerEvent*) override
+  {
+    update_inputs();
+    update_edges();
+  }
+
+  /**
+   * Called from the execution thread when the execution reaches
+   * next_offline_frame: the outputs which follow the execution are rendered
+   * on the thread of the graph.
+   *
+   * With a clock which is not real-time, the execution waits for them:
+   * slow renderers, e.g. software rasterizers, do not miss frames, the
+   * execution runs as fast as they can render. Otherwise it never waits:
+   * the frames which are due while the graph is busy repeat the next one.
+   */
+  void render_offline(double t, bool wait)
+  {
+    std::unique_lock l{m_offlineLock};
+    if (m_offlinePending)
+      return;
+    m_offlinePending = true;
+
+    QMetaObject::invokeMethod(
+        this,
+        [this, t] {
+          update_inputs();
+          update_edges();
+          next_offline_frame.store(m_graph->renderUntil(t), std::memory_order_release);
+          {
+            std::lock_guard l{m_offlineLock};
+            m_offlinePending = false;
+          }
+          m_offlineDone.notify_all();
+        },
+        Qt::QueuedConnection);
+
+    if (!wait)
+      return;
+
+    // Bounded, so that the execution does not dead-lock with
+    // a graph thread which would itself be waiting for it.
+    m_offlineDone.wait_for(l, std::chrono::seconds(1), [this] { return !m_offlinePending; });
+  }
+
+  //! Execution time at which an output driven by the execution needs a new frame
+  std::atomic<double> next_offline_frame{std::numeric_limits<double>::infinity()};
+
   std::mutex edges_lock;
   ossia::flat_set<std::pair<port_index, port_index>> new_edges;
   ossia::flat_set<std::pair<port_index, port_index>> edges;
   std::atomic_bool edges_changed{};
+
+private:
+  std::mutex m_offlineLock;
+  std::condition_variable m_offlineDone;
+  bool m_offlinePending{};
 };
 
 }
@@ -59,7 +59,14 @@ public:
 
   ~gfx_exec_node();
 
+  void register_node(std::unique_ptr<NodeModel> node)
+  {
+    id = exec_context->ui->register_node(std::move(node));
+    slots = exec_context->ui->input_slots(id);
+  }
+
   int32_t id{-1};
+  gfx_node_slots* slots{};
   void run(const ossia::token_request& tk, ossia::exec_state_facade) noexcept;
 };
 
@@ -3,6 +3,8 @@
 
 #include <Gfx/GfxContext.hpp>
 
+#include <atomic>
+
 namespace Gfx
 {
 
@@ -17,7 +19,17 @@ public:
 
   void setEdge(port_index source, port_index sink) { edges.insert({source, sink}); }
 
-  void endTick(unsigned long, double) override
+  //! Set from the GUI thread according to the clock of the execution
+  void setRealTime(bool b) noexcept { m_realTime.store(b, std::memory_order_relaxed); }
+
+  //! Called by the nodes when they run: the execution time only advances on these ticks
+  void nodeExecuted(int sampleRate) noexcept
+  {
+    m_sampleRate.store(sampleRate, std::memory_order_relaxed);
+    m_executed.store(true, std::memory_order_relaxed);
+  }
+
+  void endTick(unsigned long frameCount, double) override
   {
     if (edges != prev_edges)
     {
@@ -29,10 +41,26 @@ public:
       prev_edges = edges;
       ui->edges_changed = true;
     }
+
+    // Outputs such as video files are rendered at the pace of the execution,
+    // which only waits for them if it does not run in real-time
+    if (m_executed.exchange(false, std::memory_order_relaxed))
+    {
+      m_samples += frameCount;
+      const double t = double(m_samples) / m_sampleRate.load(std::memory_order_relaxed);
+      if (t >= ui->next_offline_frame.load(std::memory_order_acquire))
+        ui->render_offline(t, !m_realTime.load(std::memory_order_relaxed));
+    }
   }
 
   ossia::flat_set<std::pair<port_index, port_index>> prev_edges;
   ossia::flat_set<std::pair<port_index, port_index>> edges;
+
+private:
+  int64_t m_samples{};
+  std::atomic_int m_sampleRate{44100};
+  std::atomic_bool m_executed{};
+  std::atomic_bool m_realTime{true};
 };
 
 }
@@ -0,0 +1,133 @@
+#pragma once
+#include <ossia/dataflow/audio_port.hpp>
+#include <ossia/dataflow/token_request.hpp>
+#include <ossia/network/value/value.hpp>
+
+#include <Gfx/Graph/node.hpp>
+
+#include <atomic>
+#include <memory>
+#include <variant>
+#include <vector>
+
+namespace Gfx
+{
+using gfx_input = std::variant<ossia::value, ossia::audio_vector>;
+
+/**
+ * @brief Single-producer, single-consumer latest-value slot.
+ *
+ * The producer (execution thread) writes into its back buffer and publishes it;
+ * the consumer (render thread) only ever sees the most recent published value.
+ * Intermediate values are overwritten, and once the three buffers have reached
+ * their steady-state capacity no allocation happens on either side.
+ */
+template <typename T>
+class triple_buffer
+{
+public:
+  triple_buffer() = default;
+
+  triple_buffer(const triple_buffer&) = delete;
+  triple_buffer(triple_buffer&&) = delete;
+  triple_buffer& operator=(const triple_buffer&) = delete;
+  triple_buffer& operator=(triple_buffer&&) = delete;
+
+  //! Not thread-safe: only to be used before the buffer is shared
+  void reset(const T& init)
+  {
+    for (auto& buf : m_buffers)
+      buf = init;
+  }
+
+  //! Producer side: buffer to fill before calling publish()
+  T& back() noexcept { return m_buffers[m_back]; }
+
+  //! Producer side
+  void publish() noexcept
+  {
+    m_back = m_middle.exchange(m_back | dirty_bit, std::memory_order_acq_rel) & index_mask;
+  }
+
+  //! Consumer side: returns true if a new value was published since the last call
+  bool fetch() noexcept
+  {
+    if (!(m_middle.load(std::memory_order_relaxed) & dirty_bit))
+      return false;
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & index_mask;
+    return true;
+  }
+
+  //! Consumer side: latest value obtained through fetch()
+  T& front() noexcept { return m_buffers[m_front]; }
+
+private:
+  static constexpr uint8_t index_mask = 0b011;
+  static constexpr uint8_t dirty_bit = 0b100;
+
+  T m_buffers[3]{};
+  std::atomic<uint8_t> m_middle{1};
+  uint8_t m_back{0};
+  uint8_t m_front{2};
+};
+
+/**
+ * @brief Latest-value table for the inputs of a single gfx node.
+ *
+ * Allocated once when the node is registered, with one slot per input port
+ * of the NodeModel.
+ */
+struct gfx_node_slots
+{
+  explicit gfx_node_slots(const NodeModel& model)
+  {
+    const std::size_t n = model.input.size();
+    inputs = std::make_unique<triple_buffer<gfx_input>[]>(n);
+    input_count = n;
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+      if (model.input[i]->type == Types::Audio)
+        inputs[i].reset(ossia::audio_vector{});
+    }
+  }
+
+  triple_buffer<ossia::token_request> token;
+  std::unique_ptr<triple_buffer<gfx_input>[]> inputs;
+  std::size_t input_count{};
+
+  //! Producer side: overwrite the pending value of a port
+  void write(std::size_t port, ossia::value&& v) noexcept
+  {
+    if (port >= input_count)
+      return;
+
+    auto& slot = inputs[port];
+    if (auto val = std::get_if<ossia::value>(&slot.back()))
+      *val = std::move(v);
+    else
+      slot.back() = std::move(v);
+    slot.publish();
+  }
+
+  //! Producer side: copies the samples into the existing buffer to reuse its capacity
+  void write(std::size_t port, const ossia::audio_vector& v) noexcept
+  {
+    if (port >= input_count)
+      return;
+
+    auto& slot = inputs[port];
+    if (auto val = std::get_if<ossia::audio_vector>(&slot.back()))
+    {
+      val->resize(v.size());
+      for (std::size_t c = 0; c < v.size(); c++)
+        (*val)[c].assign(v[c].begin(), v[c].end());
+    }
+    else
+    {
+      slot.back() = v;
+    }
+    slot.publish();
+  }
+};
+}
@@ -142,6 +142,14 @@ void Graph::setupOutputs(GraphicsApi graphicsApi)
   }
 }
 
+double Graph::renderUntil(double t)
+{
+  double next = std::numeric_limits<double>::infinity();
+  for (auto output : outputs)
+    next = std::min(next, output->renderUntil(t));
+  return next;
+}
+
 void Graph::relinkGraph()
 {
   for (auto& rptr : renderers)
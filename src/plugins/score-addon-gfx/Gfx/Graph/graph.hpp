@@ -29,6 +29,9 @@ struct SCORE_ADDON_GFX_EXPORT Graph
 
   void relinkGraph();
 
+  //! Renders the outputs driven by the execution, see OutputNode::renderUntil
+  double renderUntil(double t);
+
   ~Graph();
 
 private:
@@ -0,0 +1,90 @@
+#include "imageloader.hpp"
+
+#include <QDebug>
+#include <QImageReader>
+#include <QRunnable>
+#include <QThread>
+
+namespace Gfx
+{
+namespace
+{
+class ImageDecodeTask final : public QRunnable
+{
+public:
+  ImageDecodeTask(QString path, QSize maxSize, std::shared_ptr<DecodedImage> res)
+      : m_path{std::move(path)}, m_maxSize{maxSize}, m_result{std::move(res)}
+  {
+  }
+
+  void run() override
+  {
+    QImageReader reader{m_path};
+    reader.setAutoTransform(true);
+
+    const QSize sz = reader.size();
+    if (sz.isValid() && m_maxSize.isValid()
+        && (sz.width() > m_maxSize.width() || sz.height() > m_maxSize.height()))
+    {
+      reader.setScaledSize(sz.scaled(m_maxSize, Qt::KeepAspectRatio));
+    }
+
+    QImage img = reader.read();
+    if (img.isNull())
+      qDebug() << "ImageLoader: could not load" << m_path << reader.errorString();
+    else
+      m_result->image = img.convertToFormat(QImage::Format_RGBA8888);
+
+    m_result->ready.store(true, std::memory_order_release);
+  }
+
+private:
+  QString m_path;
+  QSize m_maxSize;
+  std::shared_ptr<DecodedImage> m_result;
+};
+}
+
+ImageLoader& ImageLoader::instance()
+{
+  static ImageLoader self;
+  return self;
+}
+
+ImageLoader::ImageLoader()
+{
+  m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+}
+
+ImageLoader::~ImageLoader()
+{
+  m_pool.clear();
+  m_pool.waitForDone();
+}
+
+std::shared_ptr<DecodedImage> ImageLoader::load(const QString& path, QSize maxSize)
+{
+  const QString key = QStringLiteral("%1@%2x%3").arg(path).arg(maxSize.width()).arg(maxSize.height());
+
+  std::lock_guard lck{m_mutex};
+  if (auto it = m_images.find(key); it != m_images.end())
+  {
+    if (auto img = it->lock())
+      return img;
+  }
+
+  // Forget about the images nobody uses anymore
+  for (auto it = m_images.begin(); it != m_images.end();)
+  {
+    if (it->expired())
+      it = m_images.erase(it);
+    else
+      ++it;
+  }
+
+  auto img = std::make_shared<DecodedImage>();
+  m_images[key] = img;
+  m_pool.start(new ImageDecodeTask{path, maxSize, img});
+  return img;
+}
+}
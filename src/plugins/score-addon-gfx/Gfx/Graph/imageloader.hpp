@@ -0,0 +1,43 @@
+#pragma once
+#include <QHash>
+#include <QImage>
+#include <QString>
+#include <QThreadPool>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace Gfx
+{
+//! An image decoded on a worker thread: image can only be read once ready is true
+struct DecodedImage
+{
+  std::atomic_bool ready{};
+  QImage image;
+};
+
+/**
+ * @brief Decodes images asynchronously on a thread pool.
+ *
+ * Images are decoded directly to a size that fits the requested bound
+ * (e.g. the output resolution), which is much faster for large JPEGs than
+ * decoding and then scaling. Requests for an image that is still in use
+ * share the same decoded data.
+ */
+class ImageLoader
+{
+public:
+  static ImageLoader& instance();
+
+  std::shared_ptr<DecodedImage> load(const QString& path, QSize maxSize);
+
+private:
+  ImageLoader();
+  ~ImageLoader();
+
+  QThreadPool m_pool;
+  std::mutex m_mutex;
+  QHash<QString, std::weak_ptr<DecodedImage>> m_images;
+};
+}
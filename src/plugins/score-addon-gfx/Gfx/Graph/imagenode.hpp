@@ -1,5 +1,6 @@
 #pragma once
 
+#include "imageloader.hpp"
 #include "node.hpp"
 #include "renderer.hpp"
 #include "renderstate.hpp"
@@ -7,10 +8,10 @@
 
 namespace Gfx
 {
+//! The pixels are decoded by the renderers, see ImageLoader
 struct Image
 {
   QString path;
-  QImage image;
 };
 }
 
@@ -75,24 +76,36 @@ struct ImagesNode : NodeModel
   {
     using RenderedNode::RenderedNode;
 
-    bool m_uploaded = false;
     ~Rendered() { }
 
-    std::vector<QRhiTexture*> textures;
+    //! Maximum VRAM used by the images of a single node, in bytes
+    static const constexpr std::size_t vram_budget = 512 * 1024 * 1024;
+
+    struct ResidentTexture
+    {
+      QRhiTexture* texture{};
+      std::size_t bytes{};
+      int64_t lastUse{};
+    };
+
+    // Decoding requests in flight, dropped once uploaded
+    std::vector<std::shared_ptr<Gfx::DecodedImage>> decoded;
+    std::vector<ResidentTexture> resident;
+    std::size_t residentBytes{};
+    int64_t frame{};
+    int displayedIndex{-1};
+
     void customInit(Renderer& renderer) override
     {
-      prev_ubo.currentImageIndex = -1;
       auto& n = static_cast<const ImagesNode&>(this->node);
       auto& rhi = *renderer.state.rhi;
-      for (const Gfx::Image& img : n.images)
-      {
-        const QSize sz = img.image.size();
-        auto tex = rhi.newTexture(
-            QRhiTexture::BGRA8, QSize{sz.width(), sz.height()}, 1, QRhiTexture::Flag{});
 
-        tex->build();
-        textures.push_back(tex);
-      }
+      decoded.clear();
+      decoded.resize(n.images.size());
+      resident.clear();
+      resident.resize(n.images.size());
+      residentBytes = 0;
+      displayedIndex = -1;
 
       {
         auto sampler = rhi.newSampler(
@@ -107,43 +120,124 @@ struct ImagesNode : NodeModel
       }
     }
 
-    void customUpdate(Renderer& renderer, QRhiResourceUpdateBatch& res) override
+    int currentIndex() const noexcept
     {
-      if (textures.empty())
+      auto& n = static_cast<const ImagesNode&>(this->node);
+      const int count = n.images.size();
+      if (count == 0)
+        return -1;
+      return std::clamp(n.ubo.currentImageIndex, 0, count - 1);
+    }
+
+    // Render again when the image we are waiting for has been decoded
+    bool contentChanged() const noexcept override { return displayedIndex != currentIndex(); }
+
+    void request(Renderer& renderer, int i)
+    {
+      if (resident[i].texture || decoded[i])
         return;
 
+      // Images are decoded at most at the output resolution
       auto& n = static_cast<const ImagesNode&>(this->node);
-      if (!m_uploaded)
+      decoded[i] = Gfx::ImageLoader::instance().load(n.images[i].path, renderer.state.size);
+    }
+
+    QRhiTexture* upload(Renderer& renderer, QRhiResourceUpdateBatch& res, int i)
+    {
+      auto& tex = resident[i];
+      if (tex.texture)
+      {
+        tex.lastUse = frame;
+        return tex.texture;
+      }
+
+      auto& dec = decoded[i];
+      if (!dec || !dec->ready.load(std::memory_order_acquire))
+        return nullptr;
+
+      const QImage& img = dec->image;
+      if (!img.isNull())
+      {
+        auto& rhi = *renderer.state.rhi;
+        tex.texture = rhi.newTexture(QRhiTexture::RGBA8, img.size(), 1, QRhiTexture::Flag{});
+        tex.texture->build();
+        tex.bytes = img.sizeInBytes();
+        tex.lastUse = frame;
+        res.uploadTexture(tex.texture, img);
+
+        residentBytes += tex.bytes;
+        evict(i);
+
+        // The CPU copy is not needed anymore once uploaded
+        dec.reset();
+      }
+      return tex.texture;
+    }
+
+    //! Releases the least recently used textures until we are back within budget
+    void evict(int keep)
+    {
+      while (residentBytes > vram_budget)
       {
-        for (int i = 0; i < n.images.size(); i++)
+        int lru = -1;
+        for (int i = 0; i < int(resident.size()); i++)
         {
-          res.uploadTexture(textures[i], n.images[i].image);
+          if (i == keep || i == displayedIndex || !resident[i].texture)
+            continue;
+          if (lru == -1 || resident[i].lastUse < resident[lru].lastUse)
+            lru = i;
         }
-        m_uploaded = true;
+
+        if (lru == -1)
+          return;
+
+        auto& tex = resident[lru];
+        tex.texture->releaseAndDestroyLater();
+        residentBytes -= tex.bytes;
+        tex = {};
       }
+    }
 
-      if (prev_ubo.currentImageIndex != n.ubo.currentImageIndex)
+    void customUpdate(Renderer& renderer, QRhiResourceUpdateBatch& res) override
+    {
+      frame++;
+      const int idx = currentIndex();
+      if (idx < 0)
+        return;
+
+      // Prefetch the next image so that slideshows do not stall
+      request(renderer, idx);
+      request(renderer, (idx + 1) % int(resident.size()));
+
+      if (idx == displayedIndex)
+      {
+        resident[idx].lastUse = frame;
+        return;
+      }
+
+      if (auto tex = upload(renderer, res, idx))
+      {
+        replaceTexture(m_samplers[0].sampler, tex);
+        displayedIndex = idx;
+      }
+      else if (auto& dec = decoded[idx]; dec && dec->ready.load(std::memory_order_acquire))
       {
-        replaceTexture(m_samplers[0].sampler, textures[n.ubo.currentImageIndex]);
-        prev_ubo.currentImageIndex = n.ubo.currentImageIndex;
+        // Could not be decoded: do not wait for it
+        replaceTexture(m_samplers[0].sampler, renderer.m_emptyTexture);
+        displayedIndex = idx;
       }
     }
 
     void customRelease(Renderer&) override
     {
-      for (auto tex : textures)
-        tex->releaseAndDestroyLater();
-      textures.clear();
+      for (auto& tex : resident)
+        if (tex.texture)
+          tex.texture->releaseAndDestroyLater();
+      resident.clear();
+      decoded.clear();
+      residentBytes = 0;
+      displayedIndex = -1;
     }
-
-    struct ubo prev_ubo;
-    /*
-    std::optional<QSize> renderTargetSize() const noexcept override
-    {
-      auto& decoder = *static_cast<const RGB0Node&>(node).decoder;
-      const auto w = decoder.width(), h = decoder.height();
-      return QSize{w, h};
-    }*/
   };
 
   const TexturedTriangle& m_mesh = TexturedTriangle::instance();
@@ -4,6 +4,8 @@
 #include "mesh.hpp"
 #include "renderer.hpp"
 #include <score/tools/Debug.hpp>
+
+#include <cstring>
 NodeModel::NodeModel() { }
 
 void RenderedNode::createRenderTarget(const RenderState& state)
@@ -152,6 +154,8 @@ void RenderedNode::init(Renderer& renderer)
   }
 
   customInit(renderer);
+  m_passInvalidated = true;
+
   // Build the pipeline
   {
     m_ps = rhi.newGraphicsPipeline();
@@ -276,6 +280,34 @@ void RenderedNode::releaseWithoutRenderTarget(Renderer& r)
   m_meshBuffer = nullptr;
 }
 
+bool RenderedNode::mustRender(Renderer& renderer) const noexcept
+{
+  if (m_passInvalidated || contentChanged())
+    return true;
+
+  if (node.materialChanged != m_lastPassMaterial)
+    return true;
+
+  if (std::memcmp(&node.standardUBO, &m_lastPassUBO, sizeof(ProcessUBO)) != 0)
+    return true;
+
+  // Nodes are sorted topologically: upstream nodes have already been processed
+  for (const Port* in : node.input)
+  {
+    if (in->type != Types::Image)
+      continue;
+
+    for (const Edge* edge : in->edges)
+    {
+      const auto& upstream = edge->source->node->renderedNodes;
+      if (auto it = upstream.find(&renderer); it != upstream.end() && it->second)
+        if (it->second->m_renderedThisFrame)
+          return true;
+    }
+  }
+  return false;
+}
+
 void RenderedNode::runPass(
     Renderer& renderer,
     QRhiCommandBuffer& cb,
@@ -283,6 +315,10 @@ void RenderedNode::runPass(
 {
   update(renderer, updateBatch);
 
+  std::memcpy(&m_lastPassUBO, &node.standardUBO, sizeof(ProcessUBO));
+  m_lastPassMaterial = node.materialChanged;
+  m_passInvalidated = false;
+
   cb.beginPass(m_renderTarget, Qt::black, {1.0f, 0}, &updateBatch);
   {
     const auto sz = renderer.state.size;
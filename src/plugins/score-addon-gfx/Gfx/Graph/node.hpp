@@ -188,8 +188,20 @@ public:
   void release(Renderer&);
   void releaseWithoutRenderTarget(Renderer&);
 
+  //! Override for nodes whose output changes without any input change, e.g. video playback
+  virtual bool contentChanged() const noexcept { return false; }
+
+  //! True if the result of the last pass can no longer be reused
+  bool mustRender(Renderer&) const noexcept;
+
   void runPass(Renderer&, QRhiCommandBuffer& commands, QRhiResourceUpdateBatch& updateBatch);
 
+  // Pass skipping: state of the node when its texture was last rendered
+  ProcessUBO m_lastPassUBO{};
+  int64_t m_lastPassMaterial{-1};
+  bool m_passInvalidated{true};
+  bool m_renderedThisFrame{};
+
   void replaceTexture(QRhiSampler* sampler, QRhiTexture* newTexture);
 
   QRhiGraphicsPipeline* pipeline() { return m_ps; }
@@ -3,6 +3,8 @@
 #include "renderstate.hpp"
 #include "uniforms.hpp"
 
+#include <limits>
+
 class Window;
 struct OutputNode : NodeModel
 {
@@ -39,6 +41,14 @@ struct OutputNode : NodeModel
   virtual void destroyOutput() = 0;
   virtual RenderState* renderState() const = 0;
 
+  /**
+   * Outputs which do not follow a display, e.g. files, are rendered at the
+   * pace of the execution instead: this renders the frames which are due
+   * before the execution time t, in seconds, and returns the time at which
+   * the next one will be. A negative time only queries it.
+   */
+  virtual double renderUntil(double t) { return std::numeric_limits<double>::infinity(); }
+
 protected:
   OutputNode() { setShaders(m_mesh.defaultVertexShader(), filter); }
   const Mesh& mesh() const noexcept override { return this->m_mesh; }
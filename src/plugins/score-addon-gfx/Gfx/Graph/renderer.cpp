@@ -2,6 +2,8 @@
 
 #include "mesh.hpp"
 
+#include <QDebug>
+
 MeshBuffers Renderer::initMeshBuffer(const Mesh& mesh)
 {
   if (auto it = m_vertexBuffers.find(&mesh); it != m_vertexBuffers.end())
@@ -106,13 +108,38 @@ void Renderer::render(QRhiCommandBuffer& commands)
   auto updateBatch = state.rhi->nextResourceUpdateBatch();
   update(*updateBatch);
 
-  for (int i = 0; i < renderedNodes.size(); i++)
+  // Only the nodes which reach the output are in renderedNodes (see Graph::createRenderer);
+  // among those, a pass whose inputs, uniforms and upstream textures did not change since the
+  // last frame keeps its previous texture. The output is always rendered.
+  lastFrame = {};
+  const int n = renderedNodes.size();
+  for (int i = 0; i < n; i++)
   {
-    renderedNodes[i]->runPass(*this, commands, *updateBatch);
+    RenderedNode& node = *renderedNodes[i];
+    const bool isOutput = (i == n - 1);
+    if (!isOutput && !node.mustRender(*this))
+    {
+      // The pending update batch is kept for the next pass
+      node.m_renderedThisFrame = false;
+      lastFrame.skippedPasses++;
+      continue;
+    }
 
-    if (i < renderedNodes.size() - 1)
+    node.runPass(*this, commands, *updateBatch);
+    node.m_renderedThisFrame = true;
+    lastFrame.passes++;
+
+    if (!isOutput)
       updateBatch = state.rhi->nextResourceUpdateBatch();
   }
+
+  totalSkippedPasses += lastFrame.skippedPasses;
+
+  // About every ten seconds at 60 fps
+  if (++frames % 600 == 0)
+    qDebug() << "Gfx:" << lastFrame.passes << "passes rendered and" << lastFrame.skippedPasses
+             << "skipped in the last frame," << totalSkippedPasses << "skipped in" << frames
+             << "frames";
 }
 
 void Renderer::update(QRhiResourceUpdateBatch& res)
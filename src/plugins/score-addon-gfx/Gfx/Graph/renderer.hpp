@@ -27,6 +27,13 @@ struct MeshBuffers
 };
 
 struct OutputNode;
+
+struct RenderStatistics
+{
+  int passes{};
+  int skippedPasses{};
+};
+
 struct Renderer
 {
   std::vector<NodeModel*> nodes;
@@ -48,6 +55,11 @@ struct Renderer
 
   bool ready{};
 
+  //! Statistics of the last rendered frame
+  RenderStatistics lastFrame{};
+  int64_t totalSkippedPasses{};
+  int64_t frames{};
+
   void init();
   void release();
 
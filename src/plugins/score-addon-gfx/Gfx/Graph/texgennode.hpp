@@ -97,6 +97,12 @@ struct TexgenNode : NodeModel
       }
     }
 
+    // The function generates a new image on every frame
+    bool contentChanged() const noexcept override
+    {
+      return static_cast<const TexgenNode&>(this->node).function.load() != nullptr;
+    }
+
     void customRelease(Renderer&) override
     {
       texture->releaseAndDestroyLater();
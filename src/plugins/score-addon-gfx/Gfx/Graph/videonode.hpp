@@ -7,12 +7,13 @@
 #include <QElapsedTimer>
 #include <Video/VideoInterface.hpp>
 #include <ossia/detail/flicks.hpp>
+
+#include <memory>
+#include <mutex>
 extern "C"
 {
 #include <libavutil/pixdesc.h>
 }
-// TODO the "model" nodes should have a first update step so that they
-// can share data across all renderers during a tick
 using video_decoder = ::Video::VideoInterface;
 
 struct GPUVideoDecoder
@@ -431,6 +432,7 @@ struct VideoNode : NodeModel
     , nativeTempo{nativeTempo}
   {
     initGpuDecoder();
+    m_timer.start();
 
     output.push_back(new Port{this, {}, Types::Image, {}});
   }
@@ -460,6 +462,27 @@ struct VideoNode : NodeModel
         break;
     }
   }
+  bool mustReadFrame() const noexcept
+  {
+    double tempoRatio = 1.;
+    if(nativeTempo)
+      tempoRatio = (*nativeTempo) / 120.;
+
+    auto current_time = standardUBO.time * tempoRatio; // In seconds
+    auto next_frame_time = m_lastFrameTime;
+
+    // what more can we do ?
+    const double inv_fps = decoder->fps > 0
+        ? 1. / (tempoRatio * decoder->fps)
+        : 1. / 24.
+    ;
+    next_frame_time += inv_fps;
+
+    const bool we_are_late = current_time > next_frame_time;
+    const bool timer = m_timer.elapsed() > (1000. * inv_fps);
+    return we_are_late || timer;
+  }
+
   void checkFormat(AVPixelFormat fmt)
   {
     // TODO won't work if VK is threaded and there are multiple windows
@@ -483,84 +506,71 @@ struct VideoNode : NodeModel
 
   const Mesh& mesh() const noexcept override { return this->m_mesh; }
 
-  struct Rendered : RenderedNode
+  /**
+   * Frame shared by all the renderers of this node.
+   *
+   * The first renderer to need a new frame dequeues it from the decoder,
+   * the others only upload it to their own textures: with multiple outputs
+   * the video is decoded once and plays at the correct speed.
+   *
+   * The frame is given back to the decoder once the node and all the
+   * renderers which upload it have let go of it.
+   */
+  struct SharedFrame
   {
-    using RenderedNode::RenderedNode;
-    std::vector<AVFrame*> framesToFree;
-    AVPixelFormat current_format = AV_PIX_FMT_YUV420P;
-    QElapsedTimer t;
+    std::shared_ptr<AVFrame> frame;
+    int64_t index{-1};
+  };
 
-    ~Rendered()
+  SharedFrame updateFrame()
+  {
+    std::lock_guard lck{m_frameMutex};
+    if (decoder->realTime || mustReadFrame())
     {
-      auto& decoder = *static_cast<const VideoNode&>(node).decoder;
-      for (auto frame : framesToFree)
-        decoder.release_frame(frame);
+      if (auto frame = decoder->dequeue_frame())
+      {
+        checkFormat(static_cast<AVPixelFormat>(frame->format));
+
+        int64_t ts = av_frame_get_best_effort_timestamp(frame);
+        m_lastFrameTime = (decoder->flicks_per_dts * ts) / ossia::flicks_per_second<double>;
+
+        m_currentFrame.frame.reset(
+            frame, [dec = decoder](AVFrame* f) { dec->release_frame(f); });
+        m_currentFrame.index++;
+      }
+      m_timer.restart();
     }
+    return m_currentFrame;
+  }
+
+  struct Rendered : RenderedNode
+  {
+    using RenderedNode::RenderedNode;
+
+    // The uploads read the pixels of the frame in place, until the
+    // update batch is submitted: it is kept until the next one.
+    SharedFrame uploadedFrame;
 
     void customInit(Renderer& renderer) override
     {
       auto& nodem = static_cast<const VideoNode&>(node);
       if(nodem.gpu)
         nodem.gpu->init(renderer, *this);
+      uploadedFrame = {};
     }
 
-    // TODO if we have multiple renderers for the same video, we must always keep
-    // a frame because rendered may have different rates, so we cannot know "when"
-    // all renderers have rendered, thue the pattern in the following function
-    // is not enough
-    double lastFrameTime{};
     void customUpdate(Renderer& renderer, QRhiResourceUpdateBatch& res) override
     {
       auto& nodem = const_cast<VideoNode&>(static_cast<const VideoNode&>(node));
-      auto& decoder = *nodem.decoder;
-      for (auto frame : framesToFree)
-        decoder.release_frame(frame);
-      framesToFree.clear();
-
-
-      // TODO
-      auto mustReadFrame = [this, &decoder, &nodem] {
-        double tempoRatio = 1.;
-        if(nodem.nativeTempo)
-          tempoRatio = (*nodem.nativeTempo) / 120.;
-
-        auto current_time = nodem.standardUBO.time * tempoRatio; // In seconds
-        auto next_frame_time = lastFrameTime;
-
-        // what more can we do ?
-        const double inv_fps = decoder.fps > 0
-            ? 1. / (tempoRatio * decoder.fps)
-            : 1. / 24.
-        ;
-        next_frame_time += inv_fps;
-
-        const bool we_are_late = current_time > next_frame_time;
-        const bool timer = t.elapsed() > (1000. * inv_fps);
-        //const bool we_are_in_advance = std::abs(current_time - next_frame_time) > (2. * inv_fps);
-        //const bool seeked = nodem.seeked.exchange(false);
-        //const bool seeked_forward =
-        return we_are_late || timer;
-      };
-
-      if (decoder.realTime || mustReadFrame())
+
+      auto frame = nodem.updateFrame();
+      if (frame.frame && frame.index != uploadedFrame.index)
       {
-        if (auto frame = decoder.dequeue_frame())
+        if(nodem.gpu)
         {
-          nodem.checkFormat(static_cast<AVPixelFormat>(frame->format));
-          if(nodem.gpu)
-          {
-            nodem.gpu->exec(renderer, *this, res, *frame);
-          }
-
-          int64_t ts = av_frame_get_best_effort_timestamp(frame);
-          lastFrameTime = (decoder.flicks_per_dts * ts) / ossia::flicks_per_second<double>;
-
-          //qDebug() << lastFrameTime << node.standardUBO.time;
-          //qDebug() << (lastFrameTime - nodem.standardUBO.time);
-
-          framesToFree.push_back(frame);
+          nodem.gpu->exec(renderer, *this, res, *frame.frame);
         }
-        t.restart();
+        uploadedFrame = std::move(frame);
       }
     }
 
@@ -569,15 +579,23 @@ struct VideoNode : NodeModel
       auto& nodem = static_cast<const VideoNode&>(node);
       if(nodem.gpu)
         nodem.gpu->release(r, *this);
+      uploadedFrame = {};
     }
 
+    // New frames may be available at any time
+    bool contentChanged() const noexcept override { return true; }
   };
 
-  virtual ~VideoNode() { }
+  virtual ~VideoNode() = default;
+
+private:
+  std::mutex m_frameMutex;
+  SharedFrame m_currentFrame;
+  double m_lastFrameTime{};
+  QElapsedTimer m_timer;
 
+public:
   RenderedNode* createRenderer() const noexcept override {
-    auto r = new Rendered{*this};
-    r->current_format = current_format;
-    return r;
+    return new Rendered{*this};
   }
 };
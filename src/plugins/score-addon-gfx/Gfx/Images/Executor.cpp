@@ -20,7 +20,7 @@ class image_node final : public gfx_exec_node
 public:
   image_node(const std::vector<Image>& dec, GfxExecutionAction& ctx) : gfx_exec_node{ctx}
   {
-    id = exec_context->ui->register_node(std::make_unique<ImagesNode>(dec));
+    register_node(std::make_unique<ImagesNode>(dec));
   }
 
   ~image_node()
@@ -25,11 +25,8 @@ Model::Model(const TimeVal& duration, const Id<Process::ProcessModel>& id, QObje
 
   m_outlets.push_back(new TextureOutlet{Id<Process::Port>(0), this});
 
-  m_images.push_back(
-      {"/home/jcelerier/Documents/ossia.png", QImage("/home/jcelerier/Documents/ossia.png")});
-  m_images.push_back(
-      {"/home/jcelerier/Documents/IMG_1929.JPG",
-       QImage("/home/jcelerier/Documents/IMG_1929.JPG")});
+  m_images.push_back({"/home/jcelerier/Documents/ossia.png"});
+  m_images.push_back({"/home/jcelerier/Documents/IMG_1929.JPG"});
 }
 
 Model::~Model() { }
@@ -96,29 +93,40 @@ std::vector<Process::ProcessDropHandler::ProcessDrop> DropHandler::dropData(
 template <>
 void DataStreamReader::read(const Gfx::Image& proc)
 {
+  m_stream << proc.path;
 }
 
 template <>
 void DataStreamWriter::write(Gfx::Image& proc)
 {
+  m_stream >> proc.path;
 }
 
 template <>
 void JSONReader::read(const Gfx::Image& proc)
 {
+  stream.StartObject();
+  obj["Path"] = proc.path;
+  stream.EndObject();
 }
 
 template <>
 void JSONWriter::write(Gfx::Image& proc)
 {
+  proc.path = obj["Path"].toString();
 }
 
+// The images used to be saved without their path: their count was
+// directly followed by the delimiter. The list is now preceded by a
+// marker which cannot be mistaken for a count.
+static constexpr int32_t images_with_path_marker = -1;
+
 template <>
 void DataStreamReader::read(const Gfx::Images::Model& proc)
 {
   readPorts(*this, proc.m_inlets, proc.m_outlets);
 
-  m_stream << proc.m_images;
+  m_stream << images_with_path_marker << proc.m_images;
   insertDelimiter();
 }
 
@@ -132,7 +140,19 @@ void DataStreamWriter::write(Gfx::Images::Model& proc)
       proc.m_outlets,
       &proc);
 
-  m_stream >> proc.m_images;
+  int32_t marker{};
+  m_stream >> marker;
+  if (marker == images_with_path_marker)
+  {
+    m_stream >> proc.m_images;
+  }
+  else
+  {
+    // Older layout: the marker was the count of images, which were saved without any data
+    proc.m_images.clear();
+    proc.m_images.resize(std::max(marker, int32_t(0)));
+    SCORE_DEBUG_CHECK_DELIMITER;
+  }
   checkDelimiter();
 }
 
@@ -140,7 +160,7 @@ template <>
 void JSONReader::read(const Gfx::Images::Model& proc)
 {
   readPorts(*this, proc.m_inlets, proc.m_outlets);
-  // TODO
+  obj["Images"] = proc.m_images;
 }
 
 template <>
@@ -152,5 +172,8 @@ void JSONWriter::write(Gfx::Images::Model& proc)
       proc.m_inlets,
       proc.m_outlets,
       &proc);
-  // TODO
+
+  proc.m_images.clear();
+  if (auto it = obj.tryGet("Images"))
+    proc.m_images <<= *it;
 }
@@ -22,7 +22,7 @@ public:
   {
     auto n = std::make_unique<VideoNode>(dec, tempo);
     impl = n.get();
-    id = exec_context->ui->register_node(std::move(n));
+    register_node(std::move(n));
     dec->seek(0);
   }
 
@@ -0,0 +1,544 @@
+#include "VideoFileDevice.hpp"
+
+#include <State/MessageListSerialization.hpp>
+#include <State/Widgets/AddressFragmentLineEdit.hpp>
+
+#include <score/serialization/MimeVisitor.hpp>
+
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/protocol.hpp>
+
+#include <QDoubleSpinBox>
+#include <QFormLayout>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QtGui/private/qrhinull_p.h>
+
+#ifndef QT_NO_OPENGL
+#include <QOffscreenSurface>
+#include <QtGui/private/qrhigles2_p.h>
+#endif
+
+#if QT_CONFIG(vulkan)
+#include <QtGui/private/qrhivulkan_p.h>
+#endif
+
+#ifdef Q_OS_WIN
+#include <QtGui/private/qrhid3d11_p.h>
+#endif
+
+#ifdef Q_OS_DARWIN
+#include <QtGui/private/qrhimetal_p.h>
+#endif
+
+#include <Gfx/GfxApplicationPlugin.hpp>
+#include <Gfx/GfxExecContext.hpp>
+#include <Gfx/GfxParameter.hpp>
+#include <Gfx/Graph/graph.hpp>
+#include <Gfx/Graph/nodes.hpp>
+#include <Video/VideoEncoder.hpp>
+#include <wobjectimpl.h>
+
+#include <optional>
+
+W_OBJECT_IMPL(Gfx::VideoFileDevice)
+
+namespace Gfx
+{
+struct VideoFileNode : OutputNode
+{
+  VideoFileNode(const VideoFileSettings& set);
+  virtual ~VideoFileNode();
+
+  VideoFileSettings m_settings;
+
+  Renderer* m_renderer{};
+  QRhiTexture* m_texture{};
+  QRhiTextureRenderTarget* m_renderTarget{};
+  std::shared_ptr<RenderState> m_renderState{};
+  std::shared_ptr<::Video::VideoEncoder> m_encoder{};
+  QRhiReadbackResult m_readback{};
+
+  // The first frame is at the execution time where rendering started
+  std::optional<double> m_startTime;
+  int64_t m_frameIndex{};
+  bool m_rendering{};
+
+  double nextFrameTime() const noexcept;
+  QByteArray renderFrame();
+
+  double renderUntil(double t) override;
+
+  void startRendering() override;
+  void onRendererChange() override;
+  bool canRender() const override;
+  void stopRendering() override;
+
+  void setRenderer(Renderer* r) override;
+  Renderer* renderer() const override;
+
+  void createOutput(
+      GraphicsApi graphicsApi,
+      std::function<void()> onReady,
+      std::function<void()> onResize
+      ) override;
+  void destroyOutput() override;
+
+  RenderState* renderState() const override;
+  RenderedNode* createRenderer() const noexcept override;
+};
+
+class video_file_device : public ossia::net::device_base
+{
+  gfx_node_base root;
+
+public:
+  video_file_device(
+      const VideoFileSettings& set,
+      std::unique_ptr<ossia::net::protocol_base> proto,
+      std::string name)
+      : ossia::net::device_base{std::move(proto)}, root{*this, new VideoFileNode{set}, name}
+  {
+  }
+
+  const gfx_node_base& get_root_node() const override { return root; }
+  gfx_node_base& get_root_node() override { return root; }
+};
+
+static QRhi* createOffscreenRhi(GraphicsApi graphicsApi, RenderState& state)
+{
+  QRhi* rhi{};
+#if QT_CONFIG(vulkan)
+  if (graphicsApi == Vulkan)
+  {
+    if (auto inst = staticVulkanInstance())
+    {
+      QRhiVulkanInitParams params;
+      params.inst = inst;
+      rhi = QRhi::create(QRhi::Vulkan, &params, {});
+    }
+  }
+#endif
+
+#ifdef Q_OS_WIN
+  if (!rhi && graphicsApi == D3D11)
+  {
+    QRhiD3D11InitParams params;
+    rhi = QRhi::create(QRhi::D3D11, &params, {});
+  }
+#endif
+
+#ifdef Q_OS_DARWIN
+  if (!rhi && graphicsApi == Metal)
+  {
+    QRhiMetalInitParams params;
+    rhi = QRhi::create(QRhi::Metal, &params, {});
+  }
+#endif
+
+#ifndef QT_NO_OPENGL
+  // Also the fallback: works headless with a software rasterizer
+  if (!rhi)
+  {
+    state.surface = QRhiGles2InitParams::newFallbackSurface();
+    QRhiGles2InitParams params;
+    params.fallbackSurface = state.surface;
+    rhi = QRhi::create(QRhi::OpenGLES2, &params, {});
+  }
+#endif
+
+  if (!rhi)
+  {
+    QRhiNullInitParams params;
+    rhi = QRhi::create(QRhi::Null, &params, {});
+  }
+  return rhi;
+}
+
+VideoFileNode::VideoFileNode(const VideoFileSettings& set)
+  : OutputNode{}
+  , m_settings{set}
+{
+  input.push_back(new Port{this, {}, Types::Image, {}});
+}
+
+VideoFileNode::~VideoFileNode()
+{
+  destroyOutput();
+}
+
+QByteArray VideoFileNode::renderFrame()
+{
+  auto rhi = m_renderState->rhi;
+  QRhiCommandBuffer* cb{};
+  if (rhi->beginOffscreenFrame(&cb) != QRhi::FrameOpSuccess)
+    return {};
+
+  m_renderer->render(*cb);
+
+  auto batch = rhi->nextResourceUpdateBatch();
+  batch->readBackTexture(QRhiReadbackDescription{m_texture}, &m_readback);
+  cb->resourceUpdate(batch);
+
+  // QRhi waits for offscreen frames to complete: the pixels are there
+  // when this returns. Only the encoding happens on another thread.
+  rhi->endOffscreenFrame();
+  return std::exchange(m_readback.data, {});
+}
+
+double VideoFileNode::nextFrameTime() const noexcept
+{
+  if (!m_startTime)
+    return 0.;
+  return *m_startTime + m_frameIndex / m_settings.rate;
+}
+
+double VideoFileNode::renderUntil(double t)
+{
+  if (!m_rendering || !m_renderer || !m_encoder)
+    return std::numeric_limits<double>::infinity();
+
+  if (t < 0.)
+    return nextFrameTime();
+
+  if (!m_startTime)
+    m_startTime = t;
+
+  if (t < nextFrameTime())
+    return nextFrameTime();
+
+  // If the execution went past several frames in a single tick, they all
+  // show its current state. QByteArray is implicitly shared, the pixels are
+  // not copied.
+  const QByteArray pixels = renderFrame();
+  while (nextFrameTime() <= t)
+  {
+    m_encoder->enqueue_frame(pixels);
+    m_frameIndex++;
+  }
+
+  return nextFrameTime();
+}
+
+bool VideoFileNode::canRender() const
+{
+  return bool(m_renderState);
+}
+
+void VideoFileNode::startRendering()
+{
+  m_rendering = true;
+}
+
+void VideoFileNode::onRendererChange()
+{
+}
+
+void VideoFileNode::stopRendering()
+{
+  m_rendering = false;
+}
+
+void VideoFileNode::setRenderer(Renderer* r)
+{
+  m_renderer = r;
+}
+
+Renderer* VideoFileNode::renderer() const
+{
+  return m_renderer;
+}
+
+void VideoFileNode::createOutput(
+      GraphicsApi graphicsApi,
+      std::function<void ()> onReady,
+      std::function<void ()> onResize)
+{
+  m_renderState = std::make_shared<RenderState>();
+  m_renderState->rhi = createOffscreenRhi(graphicsApi, *m_renderState);
+  m_renderState->size = m_settings.size;
+
+  auto rhi = m_renderState->rhi;
+  m_texture = rhi->newTexture(
+                       QRhiTexture::RGBA8,
+                       m_renderState->size,
+                       1,
+                       QRhiTexture::RenderTarget | QRhiTexture::UsedAsTransferSource);
+  m_texture->build();
+  m_renderTarget = rhi->newTextureRenderTarget({ m_texture });
+  m_renderState->renderPassDescriptor = m_renderTarget->newCompatibleRenderPassDescriptor();
+  m_renderTarget->setRenderPassDescriptor(m_renderState->renderPassDescriptor);
+  m_renderTarget->build();
+
+  m_encoder = std::make_shared<::Video::VideoEncoder>();
+  if (!m_encoder->open(
+          m_settings.path.toStdString(),
+          m_settings.size.width(),
+          m_settings.size.height(),
+          m_settings.rate,
+          rhi->isYUpInFramebuffer()))
+  {
+    qDebug() << "VideoFileNode: could not open" << m_settings.path;
+
+    // Nothing is kept: the next call to setupOutputs tries again
+    destroyOutput();
+    return;
+  }
+
+  m_startTime.reset();
+  m_frameIndex = 0;
+
+  onReady();
+}
+
+void VideoFileNode::destroyOutput()
+{
+  m_rendering = false;
+
+  if (m_encoder)
+    m_encoder->close();
+  m_encoder.reset();
+
+  if (m_renderState)
+  {
+    delete m_renderState->renderPassDescriptor;
+    m_renderState->renderPassDescriptor = nullptr;
+
+    delete m_renderTarget;
+    m_renderTarget = nullptr;
+
+    delete m_texture;
+    m_texture = nullptr;
+
+    delete m_renderState->rhi;
+    m_renderState->rhi = nullptr;
+
+    delete m_renderState->surface;
+    m_renderState->surface = nullptr;
+
+    m_renderState.reset();
+  }
+}
+
+RenderState* VideoFileNode::renderState() const
+{
+  return m_renderState.get();
+}
+
+class VideoFileRenderer : public RenderedNode
+{
+public:
+  using RenderedNode::RenderedNode;
+  void createRenderTarget(const RenderState& state) override
+  {
+    auto& self = static_cast<const VideoFileNode&>(this->node);
+    m_renderTarget = self.m_renderTarget;
+    m_renderPass = state.renderPassDescriptor;
+  }
+};
+
+RenderedNode* VideoFileNode::createRenderer() const noexcept
+{
+  return new VideoFileRenderer{*this};
+}
+
+VideoFileDevice::~VideoFileDevice() { }
+
+bool VideoFileDevice::reconnect()
+{
+  disconnect();
+
+  try
+  {
+    auto set = this->settings().deviceSpecificSettings.value<VideoFileSettings>();
+    auto plug = m_ctx.findPlugin<DocumentPlugin>();
+    if (plug)
+    {
+      m_protocol = new gfx_protocol_base{plug->exec};
+      m_dev = std::make_unique<video_file_device>(
+          set,
+          std::unique_ptr<ossia::net::protocol_base>(m_protocol),
+          m_settings.name.toStdString());
+    }
+  }
+  catch (std::exception& e)
+  {
+    qDebug() << "Could not connect: " << e.what();
+  }
+  catch (...)
+  {
+    // TODO save the reason of the non-connection.
+  }
+
+  return connected();
+}
+
+QString VideoFileProtocolFactory::prettyName() const noexcept
+{
+  return QObject::tr("Video file output");
+}
+
+QString VideoFileProtocolFactory::category() const noexcept
+{
+  return StandardCategories::video;
+}
+
+Device::DeviceEnumerator* VideoFileProtocolFactory::getEnumerator(const score::DocumentContext& ctx) const
+{
+  return nullptr;
+}
+
+Device::DeviceInterface* VideoFileProtocolFactory::makeDevice(
+    const Device::DeviceSettings& settings,
+    const score::DocumentContext& ctx)
+{
+  return new VideoFileDevice(settings, ctx);
+}
+
+const Device::DeviceSettings& VideoFileProtocolFactory::defaultSettings() const noexcept
+{
+  static const Device::DeviceSettings settings = [&]() {
+    Device::DeviceSettings s;
+    s.protocol = concreteKey();
+    s.name = "video_out";
+    VideoFileSettings specif;
+    s.deviceSpecificSettings = QVariant::fromValue(specif);
+    return s;
+  }();
+  return settings;
+}
+
+Device::AddressDialog* VideoFileProtocolFactory::makeAddAddressDialog(
+    const Device::DeviceInterface& dev,
+    const score::DocumentContext& ctx,
+    QWidget* parent)
+{
+  return nullptr;
+}
+
+Device::AddressDialog* VideoFileProtocolFactory::makeEditAddressDialog(
+    const Device::AddressSettings& set,
+    const Device::DeviceInterface& dev,
+    const score::DocumentContext& ctx,
+    QWidget* parent)
+{
+  return nullptr;
+}
+
+Device::ProtocolSettingsWidget* VideoFileProtocolFactory::makeSettingsWidget()
+{
+  return new VideoFileSettingsWidget;
+}
+
+QVariant VideoFileProtocolFactory::makeProtocolSpecificSettings(const VisitorVariant& visitor) const
+{
+  return makeProtocolSpecificSettings_T<VideoFileSettings>(visitor);
+}
+
+void VideoFileProtocolFactory::serializeProtocolSpecificSettings(
+    const QVariant& data,
+    const VisitorVariant& visitor) const
+{
+  serializeProtocolSpecificSettings_T<VideoFileSettings>(data, visitor);
+}
+
+bool VideoFileProtocolFactory::checkCompatibility(
+    const Device::DeviceSettings& a,
+    const Device::DeviceSettings& b) const noexcept
+{
+  return a.name != b.name;
+}
+
+VideoFileSettingsWidget::VideoFileSettingsWidget(QWidget* parent) : ProtocolSettingsWidget(parent)
+{
+  m_deviceNameEdit = new State::AddressFragmentLineEdit{this};
+  m_pathEdit = new QLineEdit{this};
+
+  m_width = new QSpinBox{this};
+  m_width->setRange(16, 16384);
+  m_height = new QSpinBox{this};
+  m_height->setRange(16, 16384);
+
+  m_rate = new QDoubleSpinBox{this};
+  m_rate->setRange(1., 240.);
+
+  auto layout = new QFormLayout;
+  layout->addRow(tr("Device Name"), m_deviceNameEdit);
+  layout->addRow(tr("File"), m_pathEdit);
+  layout->addRow(tr("Width"), m_width);
+  layout->addRow(tr("Height"), m_height);
+  layout->addRow(tr("Rate"), m_rate);
+
+  setLayout(layout);
+
+  setDefaults();
+}
+
+void VideoFileSettingsWidget::setDefaults()
+{
+  m_deviceNameEdit->setText("video_out");
+  VideoFileSettings set;
+  m_pathEdit->setText(set.path);
+  m_width->setValue(set.size.width());
+  m_height->setValue(set.size.height());
+  m_rate->setValue(set.rate);
+}
+
+Device::DeviceSettings VideoFileSettingsWidget::getSettings() const
+{
+  Device::DeviceSettings s;
+  s.name = m_deviceNameEdit->text();
+  s.protocol = VideoFileProtocolFactory::static_concreteKey();
+
+  VideoFileSettings set;
+  set.path = m_pathEdit->text();
+  set.size = QSize{m_width->value(), m_height->value()};
+  set.rate = m_rate->value();
+  s.deviceSpecificSettings = QVariant::fromValue(set);
+  return s;
+}
+
+void VideoFileSettingsWidget::setSettings(const Device::DeviceSettings& settings)
+{
+  m_deviceNameEdit->setText(settings.name);
+  if (settings.deviceSpecificSettings.canConvert<VideoFileSettings>())
+  {
+    const auto set = settings.deviceSpecificSettings.value<VideoFileSettings>();
+    m_pathEdit->setText(set.path);
+    m_width->setValue(set.size.width());
+    m_height->setValue(set.size.height());
+    m_rate->setValue(set.rate);
+  }
+}
+
+}
+
+template <>
+void DataStreamReader::read(const Gfx::VideoFileSettings& n)
+{
+  m_stream << n.path << n.size << n.rate;
+  insertDelimiter();
+}
+
+template <>
+void DataStreamWriter::write(Gfx::VideoFileSettings& n)
+{
+  m_stream >> n.path >> n.size >> n.rate;
+  checkDelimiter();
+}
+
+template <>
+void JSONReader::read(const Gfx::VideoFileSettings& n)
+{
+  obj["Path"] = n.path;
+  obj["Size"] = n.size;
+  obj["Rate"] = n.rate;
+}
+
+template <>
+void JSONWriter::write(Gfx::VideoFileSettings& n)
+{
+  n.path = obj["Path"].toString();
+  n.size <<= obj["Size"];
+  n.rate = obj["Rate"].toDouble();
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <QLineEdit>
+#include <Gfx/GfxDevice.hpp>
+
+#include <Device/Protocol/DeviceInterface.hpp>
+#include <Device/Protocol/DeviceSettings.hpp>
+#include <Device/Protocol/ProtocolFactoryInterface.hpp>
+#include <Device/Protocol/ProtocolSettingsWidget.hpp>
+
+class QSpinBox;
+class QDoubleSpinBox;
+namespace Gfx
+{
+struct VideoFileSettings
+{
+  QString path;
+  QSize size{1280, 720};
+  double rate{30.};
+};
+
+class gfx_protocol_base;
+class VideoFileProtocolFactory final : public Device::ProtocolFactory
+{
+  SCORE_CONCRETE("76e2a739-7190-4345-8cda-b89172af29aa")
+  QString prettyName() const noexcept override;
+  QString category() const noexcept override;
+  Device::DeviceEnumerator* getEnumerator(const score::DocumentContext& ctx) const override;
+
+  Device::DeviceInterface*
+  makeDevice(const Device::DeviceSettings& settings, const score::DocumentContext& ctx) override;
+  const Device::DeviceSettings& defaultSettings() const noexcept override;
+  Device::AddressDialog* makeAddAddressDialog(
+      const Device::DeviceInterface& dev,
+      const score::DocumentContext& ctx,
+      QWidget* parent) override;
+  Device::AddressDialog* makeEditAddressDialog(
+      const Device::AddressSettings&,
+      const Device::DeviceInterface& dev,
+      const score::DocumentContext& ctx,
+      QWidget*) override;
+
+  Device::ProtocolSettingsWidget* makeSettingsWidget() override;
+
+  QVariant makeProtocolSpecificSettings(const VisitorVariant& visitor) const override;
+
+  void serializeProtocolSpecificSettings(const QVariant& data, const VisitorVariant& visitor)
+      const override;
+
+  bool checkCompatibility(const Device::DeviceSettings& a, const Device::DeviceSettings& b)
+      const noexcept override;
+};
+
+/**
+ * @brief Renders the graph offscreen and encodes the frames into a video file.
+ *
+ * Does not require a window system: with the OpenGL backend and a software
+ * rasterizer it can run headless.
+ *
+ * The frames follow the execution time, not the wall clock: the execution
+ * waits for each frame to be rendered, so the file is complete even when
+ * rendering is slower than real-time.
+ */
+class VideoFileDevice final : public GfxOutputDevice
+{
+  W_OBJECT(VideoFileDevice)
+public:
+  using GfxOutputDevice::GfxOutputDevice;
+  ~VideoFileDevice();
+
+private:
+  bool reconnect() override;
+  ossia::net::device_base* getDevice() const override { return m_dev.get(); }
+
+  gfx_protocol_base* m_protocol{};
+  mutable std::unique_ptr<ossia::net::device_base> m_dev;
+};
+
+class VideoFileSettingsWidget final : public Device::ProtocolSettingsWidget
+{
+public:
+  VideoFileSettingsWidget(QWidget* parent = nullptr);
+
+  Device::DeviceSettings getSettings() const override;
+
+  void setSettings(const Device::DeviceSettings& settings) override;
+
+private:
+  void setDefaults();
+  QLineEdit* m_deviceNameEdit{};
+  QLineEdit* m_pathEdit{};
+  QSpinBox* m_width{};
+  QSpinBox* m_height{};
+  QDoubleSpinBox* m_rate{};
+};
+
+}
+
+Q_DECLARE_METATYPE(Gfx::VideoFileSettings)
+W_REGISTER_ARGTYPE(Gfx::VideoFileSettings)
@@ -19,6 +19,7 @@
 #include <Gfx/Mesh/Process.hpp>
 #include <Gfx/TexturePort.hpp>
 #include <Gfx/WindowDevice.hpp>
+#include <Gfx/VideoFileDevice.hpp>
 #include <Gfx/Video/Executor.hpp>
 #include <Gfx/Video/Inspector.hpp>
 #include <Gfx/Video/Layer.hpp>
@@ -42,6 +43,7 @@ std::vector<std::unique_ptr<score::InterfaceBase>> score_addon_gfx::factories(
       FW<Device::ProtocolFactory
       , Gfx::WindowProtocolFactory
       , Gfx::CameraProtocolFactory
+      , Gfx::VideoFileProtocolFactory
 #if defined(_WIN32)
       , Gfx::SpoutProtocolFactory
 #endif
@@ -13,7 +13,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
-#include <qdom.h>
+#include <QXmlStreamReader>
 
 namespace Device
 {
@@ -108,11 +108,11 @@ static ossia::value stringToOssiaVal(const QString& str, const QString& type)
   return val;
 }
 
-static ossia::value read_valueDefault(const QDomElement& dom_element, const QString& type)
+static ossia::value read_valueDefault(const QXmlStreamAttributes& attrs, const QString& type)
 {
-  if (dom_element.hasAttribute("valueDefault"))
+  if (attrs.hasAttribute("valueDefault"))
   {
-    const auto value = dom_element.attribute("valueDefault");
+    const auto value = attrs.value("valueDefault").toString();
     return stringToVal(value, type);
   }
   else
@@ -121,13 +121,13 @@ static ossia::value read_valueDefault(const QDomElement& dom_element, const QStr
   }
 }
 
-static std::optional<ossia::access_mode> read_service(const QDomElement& dom_element)
+static std::optional<ossia::access_mode> read_service(const QXmlStreamAttributes& attrs)
 {
   using namespace score;
-  if (dom_element.hasAttribute("service"))
+  if (attrs.hasAttribute("service"))
   {
-    const auto service = dom_element.attribute("service");
-    if (service == "parameter")
+    const auto service = attrs.value("service");
+    if (service == QLatin1String("parameter"))
       return ossia::access_mode::BI;
     /*
 else if(service == "")
@@ -142,13 +142,13 @@ else if(service == "")
   return std::nullopt;
 }
 
-static auto read_rangeBounds(const QDomElement& dom_element, const QString& type)
+static auto read_rangeBounds(const QXmlStreamAttributes& attrs, const QString& type)
 {
   ossia::domain domain;
 
-  if (dom_element.hasAttribute("rangeBounds"))
+  if (attrs.hasAttribute("rangeBounds"))
   {
-    QString bounds = dom_element.attribute("rangeBounds");
+    QString bounds = attrs.value("rangeBounds").toString();
     QString minBound = bounds;
     minBound.truncate(bounds.indexOf(" "));
     bounds.remove(0, minBound.length() + 1); // contains max
@@ -164,12 +164,11 @@ static auto read_rangeBounds(const QDomElement& dom_element, const QString& type
   return domain;
 }
 
-static auto read_rangeClipmode(const QDomElement& dom_element)
+static auto read_rangeClipmode(const QXmlStreamAttributes& attrs)
 {
-  if (dom_element.hasAttribute("rangeClipmode"))
+  if (attrs.hasAttribute("rangeClipmode"))
   {
-    const auto clipmode = dom_element.attribute("rangeClipmode");
-    if (clipmode == "both")
+    if (attrs.value("rangeClipmode") == QLatin1String("both"))
     {
       return ossia::bounding_mode::CLIP;
     }
@@ -177,36 +176,37 @@ static auto read_rangeClipmode(const QDomElement& dom_element)
   return ossia::bounding_mode::FREE;
 }
 
-static void convertFromDomElement(const QDomElement& dom_element, Device::Node& parentNode)
+static void readXmlChildren(QXmlStreamReader& xml, Device::Node& parentNode);
+
+// The reader is on the start element of the node.
+// comment is the comment right before it, if any.
+static void readXmlNode(QXmlStreamReader& xml, const QString& comment, Device::Node& parentNode)
 {
-  QDomElement dom_child = dom_element.firstChildElement("");
-  QString name;
+  const auto attrs = xml.attributes();
 
-  if (dom_element.hasAttribute("address"))
+  Device::AddressSettings addr;
+  if (attrs.hasAttribute("address"))
   {
-    name = dom_element.attribute("address");
+    addr.name = attrs.value("address").toString();
   }
   else
   {
-    name = dom_element.tagName();
+    addr.name = xml.name().toString();
   }
 
-  Device::AddressSettings addr;
-  addr.name = name;
-
-  if (dom_element.hasAttribute("type"))
+  if (attrs.hasAttribute("type"))
   {
-    const auto type = dom_element.attribute("type");
-    addr.value = read_valueDefault(dom_element, type);
-    addr.ioType = read_service(dom_element);
+    const auto type = attrs.value("type").toString();
+    addr.value = read_valueDefault(attrs, type);
+    addr.ioType = read_service(attrs);
 
-    ossia::net::set_priority(addr, dom_element.attribute("priority").toInt());
-    auto rfl = dom_element.attribute("repetitionsFilter").toInt();
+    ossia::net::set_priority(addr, attrs.value("priority").toInt());
+    auto rfl = attrs.value("repetitionsFilter").toInt();
 
     addr.repetitionFilter = rfl ? ossia::repetition_filter::ON : ossia::repetition_filter::OFF;
 
-    addr.domain = read_rangeBounds(dom_element, type);
-    addr.clipMode = read_rangeClipmode(dom_element);
+    addr.domain = read_rangeBounds(attrs, type);
+    addr.clipMode = read_rangeClipmode(attrs);
 
     if (!addr.ioType)
     {
@@ -216,9 +216,9 @@ static void convertFromDomElement(const QDomElement& dom_element, Device::Node&
       }
     }
 
-    if (dom_element.previousSibling().isComment())
+    if (!comment.isNull())
     {
-      auto desc = dom_element.previousSibling().nodeValue();
+      auto desc = comment;
       if (desc.startsWith("\""))
         desc.remove(0, 1);
       if (desc.endsWith("\""))
@@ -227,53 +227,70 @@ static void convertFromDomElement(const QDomElement& dom_element, Device::Node&
     }
   }
 
-  auto& childNode = parentNode.emplace_back(addr, &parentNode);
+  auto& childNode = parentNode.emplace_back(std::move(addr), &parentNode);
+  readXmlChildren(xml, childNode);
+}
 
-  while (!dom_child.isNull() && dom_element.hasChildNodes())
+// Reads the child elements until the end of the current element
+static void readXmlChildren(QXmlStreamReader& xml, Device::Node& parentNode)
+{
+  QString comment;
+  while (!xml.atEnd())
   {
-    convertFromDomElement(dom_child, childNode);
-
-    auto ns = dom_child.nextSibling();
-    while (ns.isComment())
+    switch (xml.readNext())
     {
-      ns = ns.nextSibling();
+      case QXmlStreamReader::StartElement:
+        readXmlNode(xml, comment, parentNode);
+        comment = QString{};
+        break;
+      case QXmlStreamReader::Comment:
+        comment = xml.text().toString();
+        break;
+      case QXmlStreamReader::Characters:
+        if (!xml.isWhitespace())
+          comment = QString{};
+        break;
+      case QXmlStreamReader::EndElement:
+        return;
+      default:
+        break;
     }
-    dom_child = ns.toElement();
   }
-  return;
 }
 
 bool loadDeviceFromXML(const QString& filePath, Device::Node& node)
 {
-  // ouverture d'un xml
   QFile doc_xml(filePath);
   if (!doc_xml.open(QIODevice::ReadOnly))
   {
-    qDebug() << "Erreur : Impossible d'ouvrir le ficher XML";
-    doc_xml.close();
+    qDebug() << "Unable to open the XML file" << filePath;
     return false;
   }
 
-  QDomDocument domDoc;
-  if (!domDoc.setContent(&doc_xml))
+  // The file is read as a stream and not as a DOM:
+  // namespaces can have hundreds of thousands of nodes.
+  QXmlStreamReader xml{&doc_xml};
+  if (xml.readNextStartElement())
   {
-    qDebug() << "Erreur : Impossible de charger le ficher XML";
-    doc_xml.close();
-    return false;
+    while (xml.readNextStartElement())
+    {
+      if (xml.name() == QLatin1String("application"))
+      {
+        readXmlChildren(xml, node);
+        break;
+      }
+      xml.skipCurrentElement();
+    }
   }
 
-  doc_xml.close();
+  // Check that the rest of the file is well-formed too
+  while (!xml.atEnd())
+    xml.readNext();
 
-  // extraction des données
-
-  QDomElement doc = domDoc.documentElement();
-  QDomElement application = doc.firstChildElement("application");
-  QDomElement dom_node = application.firstChildElement("");
-
-  while (!dom_node.isNull())
+  if (xml.hasError())
   {
-    convertFromDomElement(dom_node, node);
-    dom_node = dom_node.nextSiblingElement("");
+    qDebug() << "Unable to load the XML file" << filePath << xml.errorString();
+    return false;
   }
 
   return true;
@@ -5,6 +5,7 @@
 #include <Device/Address/AddressSettings.hpp>
 #include <Device/Address/ClipMode.hpp>
 #include <Device/Address/IOType.hpp>
+#include <Device/Loading/JamomaDeviceLoader.hpp>
 #include <Device/Node/DeviceNode.hpp>
 #include <State/Domain.hpp>
 #include <State/Value.hpp>
@@ -43,7 +44,20 @@ bool loadDeviceFromScoreJSON(const QString& filePath, Device::Node& node)
     return false;
   }
 
-  return loadDeviceFromScoreJSON(readJson(doc.readAll()), node);
+  // The strings of the document point into the file data
+  auto data = doc.readAll();
+  return loadDeviceFromScoreJSON(readJsonInSitu(data), node);
+}
+
+bool loadDeviceFromFile(const QString& filePath, Device::Node& node)
+{
+  if (filePath.endsWith(".json"))
+    return loadDeviceFromScoreJSON(filePath, node);
+  else if (filePath.endsWith(".xml"))
+    return loadDeviceFromXML(filePath, node);
+  else if (filePath.endsWith(".device"))
+    return loadDeviceFromJamomaJSON(filePath, node);
+  return false;
 }
 
 }
@@ -7,4 +7,12 @@ namespace Device
 {
 SCORE_LIB_DEVICE_EXPORT bool loadDeviceFromScoreJSON(const QString& filePath, Device::Node& node);
 SCORE_LIB_DEVICE_EXPORT bool loadDeviceFromScoreJSON(const rapidjson::Document& jsonContent, Device::Node& node);
+
+/**
+ * @brief Loads a namespace file in any of the supported formats
+ * (.json, .xml, .device), according to its extension.
+ *
+ * Does not access the GUI: can be called from a worker thread.
+ */
+SCORE_LIB_DEVICE_EXPORT bool loadDeviceFromFile(const QString& filePath, Device::Node& node);
 }
@@ -9,6 +9,8 @@
 #include <State/Value.hpp>
 
 #include <score/model/tree/TreeNode.hpp>
+#include <score/tools/std/HashMap.hpp>
+#include <score/tools/std/StringHash.hpp>
 
 #include <ossia/editor/state/destination_qualifiers.hpp>
 
@@ -16,6 +18,7 @@
 
 #include <eggs/variant/variant.hpp>
 
+#include <iterator>
 #include <vector>
 
 #if !defined(SCORE_ALL_UNITY)
@@ -23,6 +26,94 @@ template class SCORE_LIB_DEVICE_EXPORT TreeNode<Device::DeviceExplorerNode>;
 #endif
 namespace Device
 {
+namespace
+{
+// Below this, a linear search in the children is faster than hashing
+static constexpr int child_index_threshold = 32;
+}
+
+struct ChildIndex::Impl
+{
+  score::hash_map<QString, const Node*> children;
+  uint32_t generation{};
+  int count{};
+
+  void rebuild(const Node& parent)
+  {
+    children.clear();
+    children.reserve(parent.childCount());
+    for (const auto& child : parent)
+    {
+      // Keep the first one in case of duplicates, like a linear search
+      children.try_emplace(child.displayName(), &child);
+    }
+    generation = parent.generation();
+    count = parent.childCount();
+  }
+
+  void update(const Node& parent)
+  {
+    if (generation != parent.generation() || count > parent.childCount())
+    {
+      rebuild(parent);
+    }
+    else if (count < parent.childCount())
+    {
+      // Only appended since the last update, e.g. while a device is explored
+      auto it = parent.end();
+      std::advance(it, count - parent.childCount());
+      for (; it != parent.end(); ++it)
+        children.try_emplace(it->displayName(), &*it);
+      count = parent.childCount();
+    }
+  }
+};
+
+ChildIndex::~ChildIndex() = default;
+
+const Node* ChildIndex::find(const Node& parent, const QString& name) const noexcept
+{
+  if (!m_impl)
+  {
+    m_impl = std::make_unique<Impl>();
+    m_impl->rebuild(parent);
+  }
+  else
+  {
+    m_impl->update(parent);
+  }
+
+  auto it = m_impl->children.find(name);
+  if (it == m_impl->children.end())
+    return nullptr;
+
+  // A child may have been renamed without the parent being notified
+  const Node* child = it->second;
+  if (child->displayName() != name)
+  {
+    m_impl->rebuild(parent);
+    it = m_impl->children.find(name);
+    return it != m_impl->children.end() ? it->second : nullptr;
+  }
+
+  return child;
+}
+
+const Device::Node* findChild(const Device::Node& n, const QString& name) noexcept
+{
+  if (n.childCount() < child_index_threshold)
+  {
+    for (const auto& child : n)
+    {
+      if (child.displayName() == name)
+        return &child;
+    }
+    return nullptr;
+  }
+
+  return n.childIndex().find(n, name);
+}
+
 bool operator<(const Device::Node& lhs, const Device::Node& rhs)
 {
   return false;
@@ -149,11 +240,8 @@ void merge(Device::Node& base, const State::Message& message)
   Node* node = &base;
   for (int i = 0; i < path.size(); i++)
   {
-    auto it = std::find_if(node->begin(), node->end(), [&](const auto& cur_node) {
-      return cur_node.displayName() == path[i];
-    });
-
-    if (it == node->end())
+    auto child = findChild(*node, path[i]);
+    if (!child)
     {
       // We have to start adding sub-nodes from here.
       Node* parentnode{node};
@@ -198,7 +286,7 @@ void merge(Device::Node& base, const State::Message& message)
     }
     else
     {
-      node = &*it;
+      node = child;
 
       if (i == path.size() - 1)
       {
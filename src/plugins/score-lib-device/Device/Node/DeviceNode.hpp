@@ -13,6 +13,9 @@
 
 #include <score_lib_device_export.h>
 
+#include <memory>
+#include <utility>
+
 class DataStream;
 class JSONObject;
 
@@ -20,6 +23,41 @@ namespace Device
 {
 struct AddressSettings;
 struct DeviceSettings;
+class DeviceExplorerNode;
+using Node = TreeNode<DeviceExplorerNode>;
+
+/**
+ * @brief Cache of the children of a node, by name.
+ *
+ * Built on the first lookup in a node with many children. Appended
+ * children are added to it, and it is rebuilt when TreeNode::generation
+ * changes. It is never copied along with the node since it points to
+ * the children.
+ */
+class SCORE_LIB_DEVICE_EXPORT ChildIndex
+{
+public:
+  ChildIndex() noexcept = default;
+  ~ChildIndex();
+  ChildIndex(const ChildIndex&) noexcept : ChildIndex{} { }
+  ChildIndex(ChildIndex&&) noexcept : ChildIndex{} { }
+  ChildIndex& operator=(const ChildIndex&) noexcept
+  {
+    m_impl.reset();
+    return *this;
+  }
+  ChildIndex& operator=(ChildIndex&&) noexcept
+  {
+    m_impl.reset();
+    return *this;
+  }
+
+  const Node* find(const Node& parent, const QString& name) const noexcept;
+
+private:
+  struct Impl;
+  mutable std::unique_ptr<Impl> m_impl;
+};
 
 class SCORE_LIB_DEVICE_EXPORT DeviceExplorerNode
     : public score::VariantBasedNode<Device::DeviceSettings, Device::AddressSettings>
@@ -58,6 +96,11 @@ public:
 
   bool isSelectable() const;
   bool isEditable() const;
+
+  const ChildIndex& childIndex() const noexcept { return m_childIndex; }
+
+private:
+  ChildIndex m_childIndex;
 };
 
 /** A data-only tree of nodes.
@@ -67,7 +110,6 @@ public:
  * They can be serialized very easily and are used as the data model of
  * Explorer::DeviceExplorerModel, as well as for serialization of devices.
  */
-using Node = TreeNode<DeviceExplorerNode>;
 using NodePath = TreePath<Device::Node>;
 
 // TODO reflist may be a better name.
@@ -107,20 +149,39 @@ SCORE_LIB_DEVICE_EXPORT Device::Node merge(Device::Node base, const State::Messa
 
 SCORE_LIB_DEVICE_EXPORT void merge(Device::Node& base, const State::Message& message);
 
+/**
+ * @brief Child of a node with a given name
+ *
+ * Nodes with many children, e.g. the namespace of large devices,
+ * are looked up through their ChildIndex.
+ */
+SCORE_LIB_DEVICE_EXPORT const Device::Node*
+findChild(const Device::Node& n, const QString& name) noexcept;
+inline Device::Node* findChild(Device::Node& n, const QString& name) noexcept
+{
+  return const_cast<Device::Node*>(findChild(std::as_const(n), name));
+}
+
 // Generic algorithms for DeviceExplorerNode-like structures.
+template <typename Node_T>
+Node_T* findChild(Node_T& n, const QString& name) noexcept
+{
+  for (auto& child : n)
+  {
+    if (child.displayName() == name)
+      return &child;
+  }
+  return nullptr;
+}
+
 template <typename Node_T, typename It>
 Node_T* try_getNodeFromString_impl(Node_T& n, It begin, It end)
 {
   if (begin == end)
     return &n;
 
-  for (auto& child : n)
-  {
-    if (child.displayName() == *begin)
-    {
-      return try_getNodeFromString_impl(child, ++begin, end);
-    }
-  }
+  if (auto child = findChild(n, *begin))
+    return try_getNodeFromString_impl(*child, ++begin, end);
 
   return nullptr;
 }
@@ -137,12 +198,8 @@ Node_T* try_getNodeFromAddress(Node_T& root, const State::Address& addr)
   if (addr.device.isEmpty())
     return &root;
 
-  auto dev = std::find_if(root.begin(), root.end(), [&](const Node_T& n) {
-    return n.template is<Device::DeviceSettings>()
-           && n.template get<Device::DeviceSettings>().name == addr.device;
-  });
-
-  if (dev == root.end())
+  auto dev = findChild(root, addr.device);
+  if (!dev || !dev->template is<Device::DeviceSettings>())
     return nullptr;
 
   return try_getNodeFromString(*dev, addr.path);
@@ -0,0 +1,123 @@
+#pragma once
+#include <Device/Node/DeviceNode.hpp>
+
+#include <score/tools/std/HashMap.hpp>
+#include <score/tools/std/StringHash.hpp>
+
+#include <iterator>
+#include <vector>
+
+namespace Device
+{
+struct NodeDiffStatistics
+{
+  int added{};
+  int removed{};
+  int updated{};
+
+  bool empty() const noexcept { return added == 0 && removed == 0 && updated == 0; }
+};
+
+/**
+ * @brief Turns the children of a node into the children of another.
+ *
+ * Children are matched by name. The ones which are not in the fresh tree
+ * anymore are removed, the new ones are appended, and the ones in both
+ * are updated in place if their settings changed, then compared
+ * recursively. Nodes which did not change are left untouched, so that
+ * what refers to them, e.g. model indexes or expanded rows, survives.
+ *
+ * The observer is told about each change, the way QAbstractItemModel
+ * needs it:
+ * - aboutToRemove(Node& parent, int first, int last) then removed()
+ * - aboutToInsert(Node& parent, int first, int last) then inserted()
+ * - updated(Node& node)
+ */
+template <typename Observer>
+void applyDiff(Node& current, const Node& fresh, Observer& obs, NodeDiffStatistics& stats)
+{
+  score::hash_map<QString, const Node*> fresh_children;
+  fresh_children.reserve(fresh.childCount());
+  for (const auto& child : fresh)
+    fresh_children.try_emplace(child.displayName(), &child);
+
+  // Remove the children which disappeared, by runs of consecutive rows.
+  // Going from the end keeps the rows before the run where they are.
+  {
+    auto it = current.end();
+    int row = current.childCount();
+    while (it != current.begin())
+    {
+      --it;
+      --row;
+      if (fresh_children.find(it->displayName()) != fresh_children.end())
+        continue;
+
+      auto first = it;
+      int first_row = row;
+      while (first != current.begin())
+      {
+        auto prev = std::prev(first);
+        if (fresh_children.find(prev->displayName()) != fresh_children.end())
+          break;
+        first = prev;
+        first_row--;
+      }
+
+      obs.aboutToRemove(current, first_row, row);
+      it = current.erase(first, std::next(it));
+      obs.removed();
+
+      stats.removed += row - first_row + 1;
+      row = first_row;
+    }
+  }
+
+  // Update the remaining ones
+  score::hash_map<QString, const Node*> current_children;
+  current_children.reserve(current.childCount());
+  for (auto& child : current)
+  {
+    const Node& other = *fresh_children.find(child.displayName())->second;
+    current_children.try_emplace(child.displayName(), &child);
+
+    if (!(child.impl() == other.impl()))
+    {
+      child.impl() = other.impl();
+      obs.updated(child);
+      stats.updated++;
+    }
+
+    applyDiff(child, other, obs, stats);
+  }
+
+  // Append the new ones
+  std::vector<const Node*> added;
+  for (const auto& child : fresh)
+  {
+    if (current_children.find(child.displayName()) == current_children.end())
+      added.push_back(&child);
+  }
+
+  if (!added.empty())
+  {
+    const int first_row = current.childCount();
+    obs.aboutToInsert(current, first_row, first_row + int(added.size()) - 1);
+    for (const Node* child : added)
+      current.emplace_back(*child, &current);
+    obs.inserted();
+
+    stats.added += int(added.size());
+  }
+}
+
+//! Observer for applyDiff when nobody has to be told about the changes
+struct NullDiffObserver
+{
+  void aboutToRemove(Node&, int, int) const noexcept { }
+  void removed() const noexcept { }
+  void aboutToInsert(Node&, int, int) const noexcept { }
+  void inserted() const noexcept { }
+  void updated(Node&) const noexcept { }
+};
+}
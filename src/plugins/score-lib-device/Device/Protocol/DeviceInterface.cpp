@@ -336,7 +336,7 @@ void DeviceInterface::disconnect()
   if (m_capas.hasCallbacks)
     disableCallbacks();
 
-  m_callbacks.clear();
+  m_listening.clear();
   if (auto dev = getDevice())
   {
     auto& root = dev->get_root_node();
@@ -401,22 +401,10 @@ void DeviceInterface::updateAddress(
   {
     if (auto node = getNodeFromPath(currentAddr.path, *dev))
     {
-      bool is_listening = m_callbacks.find(currentAddr) != m_callbacks.end();
-
       if (!settings.value.valid())
       {
-        if (is_listening)
-        {
-          // Remove callbacks
-          auto it = m_callbacks.find(currentAddr);
-          if (it != m_callbacks.end())
-          {
-            it->second.first->remove_callback(it->second.second);
-            m_callbacks.erase(it);
-          }
-
-          is_listening = false;
-        }
+        // Remove callbacks
+        m_listening.unsubscribe(currentAddr);
 
         // Remove param
         node->remove_parameter();
@@ -439,87 +427,14 @@ void DeviceInterface::updateAddress(
   }
 }
 
-void DeviceInterface::removeListening_impl(ossia::net::node_base& node, State::Address addr)
+void DeviceInterface::removeListening_impl(const State::Address& addr)
 {
-  // Find & remove our callback
-  auto it = m_callbacks.find(addr);
-  if (it != m_callbacks.end())
-  {
-    it->second.first->remove_callback(it->second.second);
-    m_callbacks.erase(it);
-  }
-
-  // Recurse
-  for (const auto& child : node.children())
-  {
-    State::Address sub_addr = addr;
-    sub_addr.path += QString::fromStdString(child->get_name());
-    removeListening_impl(*child.get(), std::move(sub_addr));
-  }
-}
-
-void DeviceInterface::removeListening_impl(
-    ossia::net::node_base& node,
-    State::Address addr,
-    std::vector<State::Address>& vec)
-{
-  // Find & remove our callback
-  auto it = m_callbacks.find(addr);
-  if (it != m_callbacks.end())
-  {
-    it->second.first->remove_callback(it->second.second);
-    m_callbacks.erase(it);
-    vec.push_back(addr);
-  }
-
-  // Recurse
-  for (const auto& child : node.children())
-  {
-    State::Address sub_addr = addr;
-    sub_addr.path += QString::fromStdString(child->get_name());
-    removeListening_impl(*child.get(), std::move(sub_addr));
-  }
-}
-bool is_parent(const State::Address& parent, const State::Address& child)
-{
-  const auto p_size = parent.path.size();
-  if (child.path.size() < p_size)
-    return false;
-  for (int i = 0; i < p_size; i++)
-  {
-    if (child.path[i] != parent.path[i])
-      return false;
-  }
-  return true;
+  m_listening.unsubscribeSubtree(addr);
 }
 
 void DeviceInterface::renameListening_impl(const State::Address& parent, const QString& newName)
 {
-  // Store the elements that are renamed
-  std::vector<std::pair<State::Address, callback_pair>> saved_elts;
-  for (auto it = m_callbacks.begin(); it != m_callbacks.end();)
-  {
-    if (is_parent(parent, it.key()))
-    {
-      State::Address addr = it.key();
-      addr.path[parent.path.size() - 1] = newName;
-      saved_elts.push_back({std::move(addr), it.value()});
-      it = m_callbacks.erase(it);
-    }
-    else
-    {
-      ++it;
-    }
-  }
-
-  // Put things back after renaming
-  for (auto&& p : std::move(saved_elts))
-  {
-    p.second.first->replace_callback(
-        p.second.second,
-        [this, addr = p.first](const ossia::value& val) { valueUpdated(addr, val); });
-    m_callbacks.insert(std::move(p));
-  }
+  m_listening.rename(parent, newName);
 }
 
 namespace
@@ -664,7 +579,7 @@ void DeviceInterface::removeNode(const State::Address& address)
     {
       /* If we are listening to this node, we recursively
        * remove listening to all the children. */
-      removeListening_impl(*node, address);
+      removeListening_impl(address);
 
       // TODO !! if we remove nodes while recording
       // (or anything involving a registered listening state), there will be
@@ -683,11 +598,15 @@ Device::Node DeviceInterface::refresh()
   if (auto dev = getDevice())
   {
     auto& root = dev->get_root_node();
-    // Clear the listening
-    removeListening_impl(root, State::Address{m_settings.name, {}});
+
+    // The parameters may be recreated by the update: listening is set up
+    // again on the ones which still exist afterwards.
+    auto listened = listening();
+    auto subtrees = m_listening.subtrees();
+    removeListening_impl(State::Address{m_settings.name, {}});
 
     disableCallbacks();
-    m_callbacks.clear();
+    m_listening.clear();
     if (dev->get_protocol().update(root))
     {
       // Make a device explorer node from the current state of the device.
@@ -702,6 +621,9 @@ Device::Node DeviceInterface::refresh()
       }
     }
     enableCallbacks();
+    addToListening(listened);
+    for (const auto& addr : subtrees)
+      setSubtreeListening(addr, true);
 
     device_node.get<Device::DeviceSettings>().name = settings().name;
   }
@@ -773,55 +695,50 @@ void DeviceInterface::setListening(const State::Address& addr, bool b)
   {
     // First check if the address is already listening
     // so that we don't have to go through the tree.
-    auto cb_it = m_callbacks.find(addr);
-
-    ossia::net::parameter_base* ossia_addr{};
-    if (cb_it == m_callbacks.end())
+    ossia::net::parameter_base* ossia_addr = m_listening.parameter(addr);
+    if (!ossia_addr)
     {
+      if (!b)
+        return;
+
       auto n = findNodeFromPath(addr.path, *dev);
       if (!n)
-      {
         return;
-      }
 
       ossia_addr = n->get_parameter();
       if (!ossia_addr)
         return;
     }
+
+    // If we want to enable listening
+    // and the address wasn't already listening
+    if (b)
+    {
+      m_listening.subscribe(addr, *ossia_addr);
+      valueUpdated(addr, ossia_addr->value());
+    }
     else
     {
-      ossia_addr = cb_it->second.first;
-      if (!ossia_addr)
-      {
-        m_callbacks.erase(cb_it);
-        return;
-      }
+      m_listening.unsubscribe(addr);
     }
+  }
+}
 
-    SCORE_ASSERT(bool(ossia_addr));
-
-    // If we want to enable listening
-    // and the address wasn't already listening
+void DeviceInterface::setSubtreeListening(const State::Address& addr, bool b)
+{
+  if (auto dev = getDevice())
+  {
     if (b)
     {
-      if (cb_it == m_callbacks.end())
-      {
-        m_callbacks.insert(
-            {addr, {ossia_addr, ossia_addr->add_callback([=](const ossia::value& val) {
-                      valueUpdated(addr, val);
-                    })}});
-      }
+      auto n = findNodeFromPath(addr.path, *dev);
+      if (!n)
+        return;
 
-      valueUpdated(addr, ossia_addr->value());
+      m_listening.subscribeSubtree(addr, *n);
     }
     else
     {
-      // If we can disable listening
-      if (cb_it != m_callbacks.end())
-      {
-        ossia_addr->remove_callback(cb_it->second.second);
-        m_callbacks.erase(cb_it);
-      }
+      m_listening.unsubscribeSubtree(addr);
     }
   }
 }
@@ -831,15 +748,7 @@ std::vector<State::Address> DeviceInterface::listening() const
   if (!connected())
     return {};
 
-  std::vector<State::Address> addrs;
-  addrs.reserve(m_callbacks.size());
-
-  for (const auto& elt : m_callbacks)
-  {
-    addrs.push_back(elt.first);
-  }
-
-  return addrs;
+  return m_listening.addresses();
 }
 
 void DeviceInterface::addToListening(const std::vector<State::Address>& addresses)
@@ -945,6 +854,11 @@ void DeviceInterface::addressCreated(const ossia::net::parameter_base& addr)
 {
   State::Address currentAddress = ToAddress(addr.get_node());
   Device::AddressSettings as = ToAddressSettings(addr.get_node());
+
+  if (m_listening.inSubscribedSubtree(currentAddress))
+    if (auto param = addr.get_node().get_parameter())
+      m_listening.subscribe(currentAddress, *param);
+
   pathUpdated(currentAddress, as);
 }
 
@@ -967,12 +881,8 @@ void DeviceInterface::addressUpdated(const ossia::net::node_base& node, ossia::s
 void DeviceInterface::addressRemoved(const ossia::net::parameter_base& addr)
 {
   auto address = ToAddress(addr.get_node());
+  m_listening.release(address);
 
-  auto cb_it = m_callbacks.find(address);
-  if (cb_it != m_callbacks.end())
-  {
-    m_callbacks.erase(cb_it);
-  }
   auto& node = addr.get_node();
   State::Address currentAddress = ToAddress(node);
   Device::AddressSettings as;
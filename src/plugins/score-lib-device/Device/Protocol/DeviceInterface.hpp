@@ -1,10 +1,9 @@
 #pragma once
 #include <Device/Node/DeviceNode.hpp>
 #include <Device/Protocol/DeviceSettings.hpp>
+#include <Device/Protocol/ListeningSubscriptions.hpp>
 
 #include <ossia-qt/device_metatype.hpp>
-#include <ossia/detail/callback_container.hpp>
-#include <ossia/network/base/value_callback.hpp>
 
 #include <nano_observer.hpp>
 #include <score_lib_device_export.h>
@@ -83,6 +82,8 @@ public:
   std::optional<ossia::value> refresh(const State::Address&);
   void request(const Device::Node&);
   void setListening(const State::Address&, bool);
+  //! Listens to all the parameters under an address, including the ones created afterwards
+  void setSubtreeListening(const State::Address&, bool);
   void addToListening(const std::vector<State::Address>&);
   std::vector<State::Address> listening() const;
 
@@ -147,16 +148,9 @@ protected:
   Device::DeviceSettings m_settings;
   DeviceCapas m_capas;
 
-  using callback_pair = std::pair<
-      ossia::net::parameter_base*,
-      ossia::callback_container<ossia::value_callback>::iterator>;
-  score::hash_map<State::Address, callback_pair> m_callbacks;
+  ListeningSubscriptions m_listening{valueUpdated};
 
-  void removeListening_impl(ossia::net::node_base& node, State::Address addr);
-  void removeListening_impl(
-      ossia::net::node_base& node,
-      State::Address addr,
-      std::vector<State::Address>&);
+  void removeListening_impl(const State::Address& addr);
   void renameListening_impl(const State::Address& parent, const QString& newName);
   void setLogging_impl(DeviceLogging) const;
   void enableCallbacks();
@@ -0,0 +1,236 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "ListeningSubscriptions.hpp"
+
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/node.hpp>
+#include <ossia/network/base/parameter.hpp>
+
+namespace Device
+{
+static bool is_parent(const State::Address& parent, const State::Address& child)
+{
+  const auto p_size = parent.path.size();
+  if (child.path.size() < p_size)
+    return false;
+  for (int i = 0; i < p_size; i++)
+  {
+    if (child.path[i] != parent.path[i])
+      return false;
+  }
+  return true;
+}
+
+ListeningSubscriptions::ListeningSubscriptions(Sink& sink) : m_sink{sink} { }
+
+ListeningSubscriptions::~ListeningSubscriptions() = default;
+
+bool ListeningSubscriptions::subscribe(
+    const State::Address& addr,
+    ossia::net::parameter_base& param)
+{
+  if (m_index.find(addr) != m_index.end())
+    return false;
+
+  Entry* e = allocate();
+  e->address = addr;
+  e->parameter = &param;
+  e->callback = param.add_callback(callback(*e));
+
+  m_index.insert({addr, e});
+  return true;
+}
+
+ListeningSubscriptions::Entry* ListeningSubscriptions::allocate()
+{
+  if (m_free.empty())
+    return m_entries.emplace_back(std::make_unique<Entry>()).get();
+
+  auto e = m_free.back();
+  m_free.pop_back();
+  return e;
+}
+
+ossia::value_callback ListeningSubscriptions::callback(Entry& e)
+{
+  // The entry does not move, so the callback only needs a pointer to it:
+  // it fits in the small buffer of the std::function.
+  return [this, e = &e](const ossia::value& val) { m_sink(e->address, val); };
+}
+
+void ListeningSubscriptions::remove(Entry& e, bool removeCallback)
+{
+  // Without its callback removed, a parameter can still send values to
+  // the entry until it is destroyed: it is then kept but never reused.
+  if (removeCallback && e.parameter)
+  {
+    e.parameter->remove_callback(e.callback);
+    m_free.push_back(&e);
+  }
+
+  e.parameter = nullptr;
+}
+
+bool ListeningSubscriptions::unsubscribe(const State::Address& addr)
+{
+  auto it = m_index.find(addr);
+  if (it == m_index.end())
+    return false;
+
+  auto& e = *it->second;
+  m_index.erase(it);
+  remove(e, true);
+  return true;
+}
+
+bool ListeningSubscriptions::release(const State::Address& addr)
+{
+  auto it = m_index.find(addr);
+  if (it == m_index.end())
+    return false;
+
+  auto& e = *it->second;
+  m_index.erase(it);
+  remove(e, false);
+  return true;
+}
+
+void ListeningSubscriptions::subscribe_rec(State::Address& addr, ossia::net::node_base& node)
+{
+  if (auto p = node.get_parameter())
+    subscribe(addr, *p);
+
+  for (const auto& child : node.children())
+  {
+    addr.path.push_back(QString::fromStdString(child->get_name()));
+    subscribe_rec(addr, *child);
+    addr.path.pop_back();
+  }
+}
+
+void ListeningSubscriptions::subscribeSubtree(
+    const State::Address& root,
+    ossia::net::node_base& node)
+{
+  if (!inSubscribedSubtree(root))
+  {
+    // A new root replaces the ones it contains
+    ossia::remove_erase_if(
+        m_subtrees, [&](const State::Address& other) { return is_parent(root, other); });
+    m_subtrees.push_back(root);
+  }
+
+  State::Address addr = root;
+  subscribe_rec(addr, node);
+}
+
+void ListeningSubscriptions::unsubscribeSubtree(const State::Address& root)
+{
+  ossia::remove_erase_if(
+      m_subtrees, [&](const State::Address& other) { return is_parent(root, other); });
+  unsubscribeUnder(root);
+}
+
+bool ListeningSubscriptions::inSubscribedSubtree(const State::Address& addr) const noexcept
+{
+  return ossia::any_of(
+      m_subtrees, [&](const State::Address& root) { return is_parent(root, addr); });
+}
+
+std::vector<State::Address> ListeningSubscriptions::unsubscribeUnder(const State::Address& root)
+{
+  std::vector<State::Address> removed;
+  for (auto it = m_index.begin(); it != m_index.end();)
+  {
+    if (is_parent(root, it->first))
+    {
+      removed.push_back(it->first);
+      remove(*it->second, true);
+      it = m_index.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  return removed;
+}
+
+void ListeningSubscriptions::rename(const State::Address& old, const QString& newName)
+{
+  if (old.path.isEmpty())
+    return;
+
+  const int renamed = old.path.size() - 1;
+
+  std::vector<Entry*> renamed_entries;
+  for (auto it = m_index.begin(); it != m_index.end();)
+  {
+    if (is_parent(old, it->first))
+    {
+      renamed_entries.push_back(it->second);
+      it = m_index.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  // The address of an entry is read by the network threads when a value
+  // comes: it is never modified. The callback is switched to a new entry
+  // with the new address, and the old entry is only reused once its
+  // callback was replaced.
+  for (Entry* e : renamed_entries)
+  {
+    Entry* ne = allocate();
+    ne->address = e->address;
+    ne->address.path[renamed] = newName;
+    ne->parameter = e->parameter;
+    ne->callback = e->callback;
+    ne->parameter->replace_callback(ne->callback, callback(*ne));
+
+    e->parameter = nullptr;
+    m_free.push_back(e);
+
+    m_index.insert({ne->address, ne});
+  }
+
+  for (auto& root : m_subtrees)
+  {
+    if (is_parent(old, root))
+      root.path[renamed] = newName;
+  }
+}
+
+ossia::net::parameter_base*
+ListeningSubscriptions::parameter(const State::Address& addr) const noexcept
+{
+  auto it = m_index.find(addr);
+  if (it == m_index.end())
+    return nullptr;
+  return it->second->parameter;
+}
+
+bool ListeningSubscriptions::contains(const State::Address& addr) const noexcept
+{
+  return m_index.find(addr) != m_index.end();
+}
+
+std::vector<State::Address> ListeningSubscriptions::addresses() const
+{
+  std::vector<State::Address> addrs;
+  addrs.reserve(m_index.size());
+  for (const auto& elt : m_index)
+    addrs.push_back(elt.first);
+  return addrs;
+}
+
+void ListeningSubscriptions::clear()
+{
+  for (auto& elt : m_index)
+    remove(*elt.second, true);
+  m_index.clear();
+  m_subtrees.clear();
+}
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <State/Address.hpp>
+
+#include <score/tools/std/HashMap.hpp>
+
+#include <ossia/detail/callback_container.hpp>
+#include <ossia/network/base/value_callback.hpp>
+
+#include <nano_signal_slot.hpp>
+#include <score_lib_device_export.h>
+
+#include <memory>
+#include <vector>
+
+namespace ossia::net
+{
+class node_base;
+class parameter_base;
+}
+
+namespace Device
+{
+/**
+ * @brief The addresses of a device which are listened to.
+ *
+ * Every subscription gets an entry which does not move, and the callback
+ * registered on the parameter only carries a pointer to it: it does not
+ * copy the address nor allocate, and an incoming value goes to the sink
+ * without any lookup. The entries are reused once their callback has been
+ * removed from the parameter.
+ *
+ * The address of an entry is never modified, since the network threads
+ * read it: renaming a node moves the callbacks of the parameters under it
+ * to new entries.
+ *
+ * A whole subtree can also be listened to: the parameters created
+ * later under it are then listened to as soon as they appear.
+ */
+class SCORE_LIB_DEVICE_EXPORT ListeningSubscriptions
+{
+public:
+  using Sink = Nano::Signal<void(const State::Address&, const ossia::value&)>;
+
+  explicit ListeningSubscriptions(Sink& sink);
+  ListeningSubscriptions(const ListeningSubscriptions&) = delete;
+  ListeningSubscriptions& operator=(const ListeningSubscriptions&) = delete;
+  ~ListeningSubscriptions();
+
+  //! Returns false if the address was already listened to
+  bool subscribe(const State::Address& addr, ossia::net::parameter_base& param);
+  //! Removes the callback from the parameter
+  bool unsubscribe(const State::Address& addr);
+  //! Forgets the address, for parameters which are being removed: their entry is not reused
+  bool release(const State::Address& addr);
+
+  //! Listens to all the parameters under a node, and the ones which will be created there.
+  void subscribeSubtree(const State::Address& root, ossia::net::node_base& node);
+  void unsubscribeSubtree(const State::Address& root);
+  bool inSubscribedSubtree(const State::Address& addr) const noexcept;
+
+  //! Unsubscribes the listened addresses at or under a node, and returns them
+  std::vector<State::Address> unsubscribeUnder(const State::Address& root);
+
+  //! The node at the address "old" was renamed to newName
+  void rename(const State::Address& old, const QString& newName);
+
+  ossia::net::parameter_base* parameter(const State::Address& addr) const noexcept;
+  bool contains(const State::Address& addr) const noexcept;
+  std::size_t size() const noexcept { return m_index.size(); }
+  std::vector<State::Address> addresses() const;
+  const std::vector<State::Address>& subtrees() const noexcept { return m_subtrees; }
+
+  //! Unsubscribes everything; the parameters must still exist
+  void clear();
+
+private:
+  struct Entry
+  {
+    State::Address address;
+    ossia::net::parameter_base* parameter{};
+    ossia::callback_container<ossia::value_callback>::iterator callback;
+  };
+
+  Entry* allocate();
+  ossia::value_callback callback(Entry& e);
+  void remove(Entry& e, bool removeCallback);
+  void subscribe_rec(State::Address& addr, ossia::net::node_base& node);
+
+  Sink& m_sink;
+  std::vector<std::unique_ptr<Entry>> m_entries;
+  std::vector<Entry*> m_free;
+  score::hash_map<State::Address, Entry*> m_index;
+  std::vector<State::Address> m_subtrees;
+};
+}
@@ -8,6 +8,7 @@
 #include <State/UpdateAddress.hpp>
 
 #include <score/tools/ForEach.hpp>
+#include <score/tools/InternedString.hpp>
 
 #include <ossia/detail/algorithms.hpp>
 #include <ossia/detail/hash.hpp>
@@ -18,6 +19,8 @@
 #include <QDebug>
 #include <QStringBuilder>
 
+#include <algorithm>
+
 #include <wobjectimpl.h>
 
 W_GADGET_IMPL(State::DestinationQualifiers)
@@ -178,7 +181,8 @@ QString Address::toShortString() const
 
 bool Address::operator==(const Address& a) const
 {
-  return device == a.device && path == a.path;
+  return score::sameString(device, a.device)
+         && std::equal(path.begin(), path.end(), a.path.begin(), a.path.end(), score::sameString);
 }
 
 bool Address::operator!=(const Address& a) const
@@ -7,11 +7,20 @@
 #include <score/serialization/DataStreamVisitor.hpp>
 #include <score/serialization/JSONVisitor.hpp>
 #include <score/serialization/VariantSerialization.hpp>
+#include <score/tools/InternedString.hpp>
 
 #include <ossia/editor/state/destination_qualifiers.hpp>
 #include <ossia/network/dataspace/dataspace_visitors.hpp>
 
 /// Address ///
+// Documents contain many addresses with the same device and node names
+static void internAddress(State::Address& a)
+{
+  a.device = score::intern(a.device);
+  for (auto& node : a.path)
+    node = score::intern(node);
+}
+
 template <>
 SCORE_LIB_STATE_EXPORT void DataStreamReader::read(const State::Address& a)
 {
@@ -30,6 +39,7 @@ template <>
 SCORE_LIB_STATE_EXPORT void DataStreamWriter::write(State::Address& a)
 {
   m_stream >> a.device >> a.path;
+  internAddress(a);
   checkDelimiter();
 }
 
@@ -38,7 +48,10 @@ SCORE_LIB_STATE_EXPORT void JSONWriter::write(State::Address& a)
 {
   auto addr = State::parseAddress(QString::fromUtf8(base.GetString(), base.GetStringLength()));
   if (addr)
+  {
     a = *std::move(addr);
+    internAddress(a);
+  }
 }
 
 /// AddressQualifiers ///
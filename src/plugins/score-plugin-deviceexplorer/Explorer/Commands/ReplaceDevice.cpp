@@ -45,20 +45,7 @@ ReplaceDevice::ReplaceDevice(
 
 static void replaceDevice(const Device::Node& new_d, const score::DocumentContext& ctx)
 {
-  auto& explorer = ctx.plugin<DeviceDocumentPlugin>().explorer();
-
-  const auto& cld = explorer.rootNode().children();
-  for (auto it = cld.begin(); it != cld.end(); ++it)
-  {
-    auto ds = it->get<Device::DeviceSettings>();
-    if (ds.name == new_d.get<Device::DeviceSettings>().name)
-    {
-      explorer.removeNode(it);
-      break;
-    }
-  }
-
-  explorer.addDevice(new_d);
+  ctx.plugin<DeviceDocumentPlugin>().explorer().replaceDevice(new_d);
 }
 void ReplaceDevice::undo(const score::DocumentContext& ctx) const
 {
@@ -7,6 +7,7 @@
 #include <Device/Protocol/DeviceSettings.hpp>
 #include <Device/Protocol/ProtocolFactoryInterface.hpp>
 #include <Device/Protocol/ProtocolList.hpp>
+#include <Explorer/Commands/DeviceExplorerCommandFactory.hpp>
 #include <Explorer/Commands/ReplaceDevice.hpp>
 #include <Explorer/DeviceList.hpp>
 #include <Explorer/DocumentPlugin/DeviceDocumentPluginFactory.hpp>
@@ -55,7 +56,19 @@ DeviceDocumentPlugin::DeviceDocumentPlugin(
   m_explorer = new DeviceExplorerModel{*this, this};
 }
 
-DeviceDocumentPlugin::~DeviceDocumentPlugin() { }
+DeviceDocumentPlugin::~DeviceDocumentPlugin()
+{
+  // The devices are only deleted with the QObject children, after the
+  // update bus: stop receiving their values before.
+  m_list.apply([this](Device::DeviceInterface& dev) {
+    dev.valueUpdated.disconnect<&DeviceDocumentPlugin::on_valueUpdated>(*this);
+  });
+}
+
+std::optional<CommandGroupKey> DeviceDocumentPlugin::commandGroup() const
+{
+  return Command::DeviceExplorerCommandFactoryName();
+}
 
 // MOVEME
 struct print_node_rec
@@ -277,9 +290,7 @@ void DeviceDocumentPlugin::setupConnections(Device::DeviceInterface& device, boo
             if (parent)
             {
               const auto& last = addr.path[addr.path.size() - 1];
-              auto it = ossia::find_if(
-                  *parent, [&](const auto& n) { return n.displayName() == last; });
-              if (it == parent->cend())
+              if (!Device::findChild(*parent, last))
               {
                 updateProxy.addLocalNode(*parent, device.getNodeWithoutChildren(addr));
               }
@@ -368,6 +379,7 @@ void DeviceDocumentPlugin::reconnect(const QString& device)
 
 void DeviceDocumentPlugin::on_valueUpdated(const State::Address& addr, const ossia::value& v)
 {
-  updateProxy.updateLocalValue(State::AddressAccessor{addr}, v);
+  // Called from the network threads
+  m_updates.push(addr, v);
 }
 }
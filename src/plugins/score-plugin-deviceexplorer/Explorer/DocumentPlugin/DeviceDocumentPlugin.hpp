@@ -3,6 +3,7 @@
 #include <Explorer/DeviceList.hpp>
 #include <Explorer/DocumentPlugin/DeviceDocumentPluginFactory.hpp>
 #include <Explorer/DocumentPlugin/NodeUpdateProxy.hpp>
+#include <Explorer/DocumentPlugin/ValueUpdateBus.hpp>
 #include <Explorer/Explorer/DeviceExplorerModel.hpp>
 #include <Explorer/Listening/ListeningHandler.hpp>
 
@@ -30,6 +31,10 @@ public:
       QObject* parent);
 
   virtual ~DeviceDocumentPlugin();
+
+  //! Only the explorer commands modify the devices
+  std::optional<CommandGroupKey> commandGroup() const override;
+
   template <typename Impl>
   DeviceDocumentPlugin(const score::DocumentContext& ctx, Impl& vis, QObject* parent)
       : score::SerializableDocumentPlugin{ctx, vis, parent}
@@ -80,5 +85,8 @@ private:
 
 public:
   NodeUpdateProxy updateProxy{*this};
+
+private:
+  ValueUpdateBus m_updates{*this};
 };
 }
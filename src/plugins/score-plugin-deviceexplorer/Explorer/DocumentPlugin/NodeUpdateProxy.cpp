@@ -195,6 +195,21 @@ void NodeUpdateProxy::updateLocalValue(const State::AddressAccessor& addr, const
   devModel.explorer().updateValue(n, addr, v);
 }
 
+void NodeUpdateProxy::updateLocalValues(
+    const std::vector<std::pair<State::Address, ossia::value>>& values)
+{
+  std::vector<std::pair<Device::Node*, ossia::value>> nodes;
+  nodes.reserve(values.size());
+  for (const auto& [addr, v] : values)
+  {
+    auto n = Device::try_getNodeFromAddress(devModel.rootNode(), addr);
+    if (n && n->template is<Device::AddressSettings>())
+      nodes.emplace_back(n, v);
+  }
+
+  devModel.explorer().updateValues(nodes);
+}
+
 void NodeUpdateProxy::updateLocalSettings(
     const State::Address& addr,
     const Device::AddressSettings& set,
@@ -6,6 +6,8 @@
 
 #include <score_plugin_deviceexplorer_export.h>
 
+#include <vector>
+
 namespace State
 {
 struct Address;
@@ -84,6 +86,7 @@ public:
 
   void removeLocalNode(const State::Address&);
   void updateLocalValue(const State::AddressAccessor&, const ossia::value&);
+  void updateLocalValues(const std::vector<std::pair<State::Address, ossia::value>>&);
   void updateLocalSettings(
       const State::Address&,
       const Device::AddressSettings&,
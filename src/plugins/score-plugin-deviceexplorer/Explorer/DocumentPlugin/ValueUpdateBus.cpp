@@ -0,0 +1,66 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "ValueUpdateBus.hpp"
+
+#include "DeviceDocumentPlugin.hpp"
+
+#include <Explorer/Settings/ExplorerModel.hpp>
+
+#include <score/application/ApplicationContext.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace Explorer
+{
+ValueUpdateBus::ValueUpdateBus(DeviceDocumentPlugin& plug) : m_plug{plug}
+{
+  m_timer.setSingleShot(true);
+  QObject::connect(&m_timer, &QTimer::timeout, [this] { drain(); });
+}
+
+ValueUpdateBus::~ValueUpdateBus() = default;
+
+void ValueUpdateBus::push(const State::Address& addr, const ossia::value& v)
+{
+  {
+    std::lock_guard lck{m_mutex};
+    m_pending.insert_or_assign(addr, v);
+    if (m_scheduled)
+      return;
+    m_scheduled = true;
+  }
+
+  // The timer lives in the main thread
+  QMetaObject::invokeMethod(&m_timer, [this] { schedule(); }, Qt::QueuedConnection);
+}
+
+void ValueUpdateBus::schedule()
+{
+  if (m_timer.isActive())
+    return;
+
+  const int rate = m_plug.context().app.settings<Settings::Model>().getUpdateRate();
+  m_timer.start(1000 / std::max(1, rate));
+}
+
+void ValueUpdateBus::drain()
+{
+  decltype(m_pending) pending;
+  {
+    std::lock_guard lck{m_mutex};
+    pending.swap(m_pending);
+    m_scheduled = false;
+  }
+
+  if (pending.empty())
+    return;
+
+  std::vector<std::pair<State::Address, ossia::value>> values;
+  values.reserve(pending.size());
+  for (auto& [addr, v] : pending)
+    values.emplace_back(addr, v);
+
+  m_plug.updateProxy.updateLocalValues(values);
+}
+}
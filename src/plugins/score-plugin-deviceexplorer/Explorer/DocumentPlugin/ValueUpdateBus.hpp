@@ -0,0 +1,47 @@
+#pragma once
+#include <State/Address.hpp>
+#include <State/Value.hpp>
+
+#include <score/tools/std/HashMap.hpp>
+
+#include <QTimer>
+
+#include <score_plugin_deviceexplorer_export.h>
+
+#include <mutex>
+
+namespace Explorer
+{
+class DeviceDocumentPlugin;
+
+/**
+ * @brief Coalesces the values received from the devices before they are shown.
+ *
+ * Values are pushed from the network threads: only the latest value of
+ * each address is kept until the next update of the device explorer,
+ * which happens at most at the rate set in the settings.
+ * A sensor sending at 1 kHz thus only causes a few model updates per second.
+ */
+class SCORE_PLUGIN_DEVICEEXPLORER_EXPORT ValueUpdateBus
+{
+public:
+  explicit ValueUpdateBus(DeviceDocumentPlugin& plug);
+  ~ValueUpdateBus();
+
+  //! Can be called from any thread
+  void push(const State::Address& addr, const ossia::value& v);
+
+  //! Applies the pending values to the device explorer
+  void drain();
+
+private:
+  void schedule();
+
+  DeviceDocumentPlugin& m_plug;
+  QTimer m_timer;
+
+  std::mutex m_mutex;
+  score::hash_map<State::Address, ossia::value> m_pending;
+  bool m_scheduled{};
+};
+}
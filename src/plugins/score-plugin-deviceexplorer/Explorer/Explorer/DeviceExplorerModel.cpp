@@ -6,6 +6,7 @@
 #include <Device/ItemModels/NodeBasedItemModel.hpp>
 #include <Device/ItemModels/NodeDisplayMethods.hpp>
 #include <Device/Node/DeviceNode.hpp>
+#include <Device/Node/NodeDiff.hpp>
 #include <Device/Node/NodeListMimeSerialization.hpp>
 #include <Device/Protocol/DeviceSettings.hpp>
 #include <Device/Protocol/ProtocolFactoryInterface.hpp>
@@ -32,6 +33,7 @@
 #include <score/plugins/StringFactoryKey.hpp>
 #include <score/serialization/JSONVisitor.hpp>
 #include <score/serialization/MimeVisitor.hpp>
+#include <score/tools/std/HashMap.hpp>
 
 #include <ossia/editor/state/destination_qualifiers.hpp>
 #include <ossia/network/base/node_attributes.hpp>
@@ -47,6 +49,7 @@
 
 #include <wobjectimpl.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -139,6 +142,7 @@ void DeviceExplorerModel::updateDevice(const QString& name, const Device::Device
     if (n.get<Device::DeviceSettings>().name == name)
     {
       n.set(dev);
+      m_rootNode.childrenChanged();
 
       QModelIndex index = createIndex(i, 0, n.parent());
       dataChanged(index, index);
@@ -148,6 +152,57 @@ void DeviceExplorerModel::updateDevice(const QString& name, const Device::Device
   }
 }
 
+void DeviceExplorerModel::replaceDevice(const Device::Node& deviceNode)
+{
+  const auto& name = deviceNode.get<Device::DeviceSettings>().name;
+  auto it = m_rootNode.begin();
+  for (; it != m_rootNode.end(); ++it)
+  {
+    if (it->get<Device::DeviceSettings>().name == name)
+      break;
+  }
+
+  if (it == m_rootNode.end())
+  {
+    addDevice(deviceNode);
+    return;
+  }
+
+  // Only the nodes which changed are touched: the rows which stay keep
+  // their expanded state and what listens to them.
+  struct observer
+  {
+    DeviceExplorerModel& self;
+
+    void aboutToRemove(Device::Node& parent, int first, int last)
+    {
+      self.beginRemoveRows(self.modelIndexFromNode(parent, 0), first, last);
+    }
+    void removed() { self.endRemoveRows(); }
+    void aboutToInsert(Device::Node& parent, int first, int last)
+    {
+      self.beginInsertRows(self.modelIndexFromNode(parent, 0), first, last);
+    }
+    void inserted() { self.endInsertRows(); }
+    void updated(Device::Node& node)
+    {
+      self.dataChanged(
+          self.modelIndexFromNode(node, 0),
+          self.modelIndexFromNode(node, (int)Column::Count - 1));
+    }
+  } obs{*this};
+
+  auto& n = *it;
+  if (!(n.impl() == deviceNode.impl()))
+  {
+    n.impl() = deviceNode.impl();
+    obs.updated(n);
+  }
+
+  Device::NodeDiffStatistics stats;
+  Device::applyDiff(n, deviceNode, obs, stats);
+}
+
 void DeviceExplorerModel::addAddress(
     Device::Node* parentNode,
     const Device::AddressSettings& addressSettings,
@@ -198,6 +253,8 @@ void DeviceExplorerModel::updateAddress(
   SCORE_ASSERT(node != &m_rootNode);
 
   node->set(addressSettings);
+  // The name may have changed
+  node->parent()->childrenChanged();
 
   nodeChanged(node);
 
@@ -220,6 +277,52 @@ void DeviceExplorerModel::updateValue(
   dataChanged(nodeIndex, nodeIndex);
 }
 
+void DeviceExplorerModel::updateValues(
+    const std::vector<std::pair<Device::Node*, ossia::value>>& values)
+{
+  score::hash_map<Device::Node*, std::vector<const Device::Node*>> changed;
+  for (const auto& [n, v] : values)
+  {
+    n->get<Device::AddressSettings>().value = v;
+    changed[n->parent()].push_back(n);
+  }
+
+  // Look for the rows of all the changed children in a single pass
+  // over their parent instead of calling indexOfChild for each.
+  for (auto it = changed.begin(); it != changed.end(); ++it)
+  {
+    const Device::Node* parent = it->first;
+    auto& sorted = it.value();
+    std::sort(sorted.begin(), sorted.end());
+
+    int row = 0;
+    int first_row = -1, last_row = -1;
+    const Device::Node* first{};
+    const Device::Node* last{};
+    for (const auto& child : *parent)
+    {
+      if (std::binary_search(sorted.begin(), sorted.end(), &child))
+      {
+        if (!first)
+        {
+          first = &child;
+          first_row = row;
+        }
+        last = &child;
+        last_row = row;
+      }
+      row++;
+    }
+
+    if (first)
+    {
+      dataChanged(
+          createIndex(first_row, 1, const_cast<Device::Node*>(first)),
+          createIndex(last_row, 1, const_cast<Device::Node*>(last)));
+    }
+  }
+}
+
 bool DeviceExplorerModel::checkDeviceInstantiatable(Device::DeviceSettings& n)
 {
   // No name -> no love
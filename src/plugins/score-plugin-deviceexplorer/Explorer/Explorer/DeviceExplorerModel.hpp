@@ -89,6 +89,9 @@ public:
   int addDevice(Device::Node&& deviceNode);
   int addDevice(const Device::Node& deviceNode);
   void updateDevice(const QString& name, const Device::DeviceSettings& dev);
+  //! Replaces the namespace of the device with the same name in place:
+  //! only the nodes which were added, removed or changed are updated.
+  void replaceDevice(const Device::Node& deviceNode);
 
   void
   addAddress(Device::Node* parentNode, const Device::AddressSettings& addressSettings, int row);
@@ -97,6 +100,8 @@ public:
   void addNode(Device::Node* parentNode, Device::Node&& child, int row);
 
   void updateValue(Device::Node* n, const State::AddressAccessor& addr, const ossia::value& v);
+  //! Emits a single dataChanged for the changed siblings of each node
+  void updateValues(const std::vector<std::pair<Device::Node*, ossia::value>>& values);
 
   // Checks if the settings can be added; if not,
   // trigger a dialog to edit them as wanted.
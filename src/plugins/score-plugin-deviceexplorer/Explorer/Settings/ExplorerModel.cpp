@@ -14,10 +14,11 @@ SETTINGS_PARAMETER_IMPL(LocalTree){QStringLiteral("score_plugin_LocalTree"), tru
 SETTINGS_PARAMETER_IMPL(LogLevel){
     QStringLiteral("score_plugin_engine/LogLevel"),
     DeviceLogLevel{}.logEverything};
+SETTINGS_PARAMETER_IMPL(UpdateRate){QStringLiteral("score_plugin_deviceexplorer/UpdateRate"), 30};
 
 static auto list()
 {
-  return std::tie(LocalTree, LogLevel);
+  return std::tie(LocalTree, LogLevel, UpdateRate);
 }
 }
 
@@ -28,6 +29,7 @@ Model::Model(QSettings& set, const score::ApplicationContext& ctx)
 
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, LocalTree)
 SCORE_SETTINGS_PARAMETER_CPP(QString, Model, LogLevel)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, UpdateRate)
 }
 
 namespace Explorer::ProjectSettings
@@ -21,15 +21,19 @@ class SCORE_PLUGIN_DEVICEEXPLORER_EXPORT Model : public score::SettingsDelegateM
 
   bool m_LocalTree = false;
   QString m_LogLevel;
+  int m_UpdateRate = 30;
 
 public:
   Model(QSettings& set, const score::ApplicationContext& ctx);
 
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, bool, LocalTree)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, QString, LogLevel)
+  //! Maximum number of updates per second of the listened values
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_DEVICEEXPLORER_EXPORT, int, UpdateRate)
 };
 
 SCORE_SETTINGS_PARAMETER(Model, LogLevel)
+SCORE_SETTINGS_PARAMETER(Model, UpdateRate)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, LocalTree)
 }
 
@@ -9,6 +9,7 @@
 
 #include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
 namespace Explorer::Settings
 {
 View::View()
@@ -17,6 +18,8 @@ View::View()
   auto lay = m_widg->layout();
 
   SETTINGS_UI_COMBOBOX_SETUP("Log level", LogLevel, DeviceLogLevel{});
+  SETTINGS_UI_SPINBOX_SETUP("Value updates per second", UpdateRate);
+  m_UpdateRate->setRange(1, 240);
 
   m_cb = new QCheckBox{tr("Enable local tree")};
   lay->addRow(m_cb);
@@ -36,6 +39,7 @@ QWidget* View::getWidget()
 }
 
 SETTINGS_UI_COMBOBOX_IMPL(LogLevel)
+SETTINGS_UI_SPINBOX_IMPL(UpdateRate)
 }
 
 namespace Explorer::ProjectSettings
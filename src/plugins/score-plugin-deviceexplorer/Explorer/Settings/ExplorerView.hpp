@@ -19,6 +19,7 @@ public:
   void localTreeChanged(int arg_1) W_SIGNAL(localTreeChanged, arg_1);
 
   SETTINGS_UI_COMBOBOX_HPP(LogLevel)
+  SETTINGS_UI_SPINBOX_HPP(UpdateRate)
 
 private:
   QWidget* getWidget() override;
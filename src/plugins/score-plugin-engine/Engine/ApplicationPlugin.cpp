@@ -365,22 +365,8 @@ void ApplicationPlugin::on_documentChanged(score::Document* olddoc, score::Docum
             if (&dev != list.audioDevice() && &dev != list.localDevice())
               if (dev.connected())
               {
-                auto old_name = dev.name();
                 auto new_node = dev.refresh();
-
-                auto& explorer = doc_plugin.explorer();
-                const auto& cld = explorer.rootNode().children();
-                for (auto it = cld.begin(); it != cld.end(); ++it)
-                {
-                  auto ds = it->get<Device::DeviceSettings>();
-                  if (ds.name == old_name)
-                  {
-                    explorer.removeNode(it);
-                    break;
-                  }
-                }
-
-                explorer.addDevice(std::move(new_node));
+                doc_plugin.explorer().replaceDevice(new_node);
               }
           });
         }
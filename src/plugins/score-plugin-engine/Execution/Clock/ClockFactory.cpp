@@ -19,6 +19,11 @@ namespace Execution
 Clock::~Clock() = default;
 ClockFactory::~ClockFactory() = default;
 
+bool ClockFactory::realTime() const noexcept
+{
+  return true;
+}
+
 Clock::Clock(const Context& ctx)
     : context{ctx}, scenario{context.doc.plugin<DocumentPlugin>().baseScenario()}
 {
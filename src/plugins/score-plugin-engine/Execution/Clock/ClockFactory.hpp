@@ -71,6 +71,10 @@ public:
   virtual time_function makeTimeFunction(const score::DocumentContext& ctx) const = 0;
   virtual reverse_time_function
   makeReverseTimeFunction(const score::DocumentContext& ctx) const = 0;
+
+  //! False if the clock does not follow the wall clock, e.g. when rendering offline:
+  //! outputs can then make the execution wait for them.
+  virtual bool realTime() const noexcept;
 };
 
 class SCORE_PLUGIN_ENGINE_EXPORT ClockFactoryList final : public score::InterfaceList<ClockFactory>
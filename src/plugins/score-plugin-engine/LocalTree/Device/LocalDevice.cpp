@@ -85,7 +85,7 @@ void LocalDevice::disconnect()
 
 bool LocalDevice::reconnect()
 {
-  m_callbacks.clear();
+  m_listening.clear();
   setRemoteSettings(settings());
   return connected();
 }
@@ -0,0 +1,277 @@
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/imgutils.h>
+#include <libswscale/swscale.h>
+}
+#include "VideoEncoder.hpp"
+
+#include <QDebug>
+
+namespace Video
+{
+
+VideoEncoder::VideoEncoder() noexcept { }
+
+VideoEncoder::~VideoEncoder() noexcept
+{
+  close();
+}
+
+bool VideoEncoder::open(
+    const std::string& outputFile,
+    int width,
+    int height,
+    double fps,
+    bool flip) noexcept
+{
+  close();
+
+  if (width <= 0 || height <= 0 || fps <= 0.)
+    return false;
+
+  m_width = width;
+  m_height = height;
+  m_flip = flip;
+  m_pts = 0;
+  m_written = 0;
+
+  if (avformat_alloc_output_context2(&m_formatContext, nullptr, nullptr, outputFile.c_str()) < 0
+      || !m_formatContext)
+  {
+    qDebug() << "VideoEncoder: unknown output format for" << outputFile.c_str();
+    close_file();
+    return false;
+  }
+
+  const AVCodec* codec = avcodec_find_encoder(m_formatContext->oformat->video_codec);
+  if (!codec)
+  {
+    qDebug() << "VideoEncoder: no encoder for" << outputFile.c_str();
+    close_file();
+    return false;
+  }
+
+  m_stream = avformat_new_stream(m_formatContext, nullptr);
+  m_codecContext = avcodec_alloc_context3(codec);
+  if (!m_stream || !m_codecContext)
+  {
+    close_file();
+    return false;
+  }
+
+  // Most YUV encoders require even dimensions
+  const AVRational rate = av_d2q(fps, 100000);
+  m_codecContext->width = width - (width % 2);
+  m_codecContext->height = height - (height % 2);
+  m_codecContext->time_base = av_inv_q(rate);
+  m_codecContext->framerate = rate;
+  m_codecContext->gop_size = 12;
+  m_codecContext->pix_fmt = codec->pix_fmts ? codec->pix_fmts[0] : AV_PIX_FMT_YUV420P;
+  if (m_formatContext->oformat->flags & AVFMT_GLOBALHEADER)
+    m_codecContext->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+  m_stream->time_base = m_codecContext->time_base;
+
+  if (avcodec_open2(m_codecContext, codec, nullptr) < 0
+      || avcodec_parameters_from_context(m_stream->codecpar, m_codecContext) < 0)
+  {
+    qDebug() << "VideoEncoder: could not open the encoder";
+    close_file();
+    return false;
+  }
+
+  m_packet = av_packet_alloc();
+  m_frame = av_frame_alloc();
+  if (!m_packet || !m_frame)
+  {
+    close_file();
+    return false;
+  }
+
+  m_frame->format = m_codecContext->pix_fmt;
+  m_frame->width = m_codecContext->width;
+  m_frame->height = m_codecContext->height;
+  if (av_frame_get_buffer(m_frame, 0) < 0)
+  {
+    close_file();
+    return false;
+  }
+
+  m_sws = sws_getContext(
+      width,
+      height,
+      AV_PIX_FMT_RGBA,
+      m_codecContext->width,
+      m_codecContext->height,
+      m_codecContext->pix_fmt,
+      SWS_BILINEAR,
+      nullptr,
+      nullptr,
+      nullptr);
+  if (!m_sws)
+  {
+    close_file();
+    return false;
+  }
+
+  if (!(m_formatContext->oformat->flags & AVFMT_NOFILE))
+  {
+    if (avio_open(&m_formatContext->pb, outputFile.c_str(), AVIO_FLAG_WRITE) < 0)
+    {
+      qDebug() << "VideoEncoder: could not open" << outputFile.c_str();
+      close_file();
+      return false;
+    }
+  }
+
+  if (avformat_write_header(m_formatContext, nullptr) < 0)
+  {
+    close_file();
+    return false;
+  }
+
+  m_running.store(true, std::memory_order_release);
+  m_thread = std::thread{[this] { this->encode_thread(); }};
+  return true;
+}
+
+void VideoEncoder::close() noexcept
+{
+  if (m_thread.joinable())
+  {
+    {
+      std::lock_guard lck{m_condMut};
+      m_running.store(false, std::memory_order_release);
+    }
+    m_condVar.notify_all();
+    m_thread.join();
+
+    // The thread only runs once the header has been written:
+    // flush the delayed frames and finish the file.
+    avcodec_send_frame(m_codecContext, nullptr);
+    write_packets();
+    av_write_trailer(m_formatContext);
+  }
+
+  close_file();
+}
+
+void VideoEncoder::enqueue_frame(QByteArray rgba) noexcept
+{
+  if (!m_running.load(std::memory_order_acquire))
+    return;
+
+  {
+    std::unique_lock lck{m_condMut};
+    m_condVar.wait(lck, [&] {
+      return int(m_frames.size()) < frames_to_buffer
+             || !m_running.load(std::memory_order_acquire);
+    });
+    m_frames.push_back(std::move(rgba));
+  }
+  m_condVar.notify_all();
+}
+
+void VideoEncoder::encode_thread() noexcept
+{
+  for (;;)
+  {
+    QByteArray frame;
+    {
+      std::unique_lock lck{m_condMut};
+      m_condVar.wait(lck, [&] {
+        return !m_frames.empty() || !m_running.load(std::memory_order_acquire);
+      });
+
+      // Frames already submitted are still written when closing
+      if (m_frames.empty())
+        return;
+
+      frame = std::move(m_frames.front());
+      m_frames.pop_front();
+    }
+    m_condVar.notify_all();
+
+    encode(frame);
+  }
+}
+
+void VideoEncoder::encode(const QByteArray& rgba) noexcept
+{
+  const int stride = m_width * 4;
+  if (rgba.size() < stride * m_height)
+    return;
+
+  if (av_frame_make_writable(m_frame) < 0)
+    return;
+
+  auto data = reinterpret_cast<const uint8_t*>(rgba.constData());
+  const uint8_t* src[1]{data};
+  int src_stride[1]{stride};
+  if (m_flip)
+  {
+    // Bottom-up framebuffer, e.g. OpenGL
+    src[0] = data + stride * (m_height - 1);
+    src_stride[0] = -stride;
+  }
+
+  sws_scale(m_sws, src, src_stride, 0, m_height, m_frame->data, m_frame->linesize);
+
+  m_frame->pts = m_pts++;
+  if (avcodec_send_frame(m_codecContext, m_frame) < 0)
+    return;
+
+  write_packets();
+  m_written.fetch_add(1, std::memory_order_relaxed);
+}
+
+void VideoEncoder::write_packets() noexcept
+{
+  while (avcodec_receive_packet(m_codecContext, m_packet) >= 0)
+  {
+    av_packet_rescale_ts(m_packet, m_codecContext->time_base, m_stream->time_base);
+    m_packet->stream_index = m_stream->index;
+    av_interleaved_write_frame(m_formatContext, m_packet);
+    av_packet_unref(m_packet);
+  }
+}
+
+void VideoEncoder::close_file() noexcept
+{
+  m_frames.clear();
+
+  if (m_sws)
+  {
+    sws_freeContext(m_sws);
+    m_sws = nullptr;
+  }
+
+  if (m_frame)
+  {
+    av_frame_free(&m_frame);
+  }
+
+  if (m_packet)
+  {
+    av_packet_free(&m_packet);
+  }
+
+  if (m_codecContext)
+  {
+    avcodec_free_context(&m_codecContext);
+  }
+
+  if (m_formatContext)
+  {
+    if (m_formatContext->pb && !(m_formatContext->oformat->flags & AVFMT_NOFILE))
+      avio_closep(&m_formatContext->pb);
+    avformat_free_context(m_formatContext);
+    m_formatContext = nullptr;
+  }
+
+  m_stream = nullptr;
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <QByteArray>
+
+#include <score_plugin_media_export.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <condition_variable>
+
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVStream;
+struct AVFrame;
+struct AVPacket;
+struct SwsContext;
+namespace Video
+{
+
+/**
+ * @brief Encodes RGBA8 frames into a video file.
+ *
+ * Frames are pushed from the rendering thread and encoded on a dedicated
+ * thread. Timestamps are derived from the frame index, so the resulting file
+ * is constant-rate regardless of how fast frames are produced.
+ */
+class SCORE_PLUGIN_MEDIA_EXPORT VideoEncoder final
+{
+public:
+  VideoEncoder() noexcept;
+  ~VideoEncoder() noexcept;
+
+  //! The output format and codec are deduced from the file extension
+  bool open(const std::string& outputFile, int width, int height, double fps, bool flip) noexcept;
+  void close() noexcept;
+
+  //! Blocks if the encoder is more than frames_to_buffer frames late
+  void enqueue_frame(QByteArray rgba) noexcept;
+
+  int64_t frames_written() const noexcept { return m_written.load(std::memory_order_relaxed); }
+
+private:
+  void encode_thread() noexcept;
+  void encode(const QByteArray& rgba) noexcept;
+  void write_packets() noexcept;
+  void close_file() noexcept;
+
+  static const constexpr int frames_to_buffer = 8;
+
+  std::thread m_thread;
+  std::mutex m_condMut;
+  std::condition_variable m_condVar;
+  std::deque<QByteArray> m_frames;
+
+  AVFormatContext* m_formatContext{};
+  AVCodecContext* m_codecContext{};
+  AVStream* m_stream{};
+  AVFrame* m_frame{};
+  AVPacket* m_packet{};
+  SwsContext* m_sws{};
+
+  int m_width{};
+  int m_height{};
+  bool m_flip{};
+  int64_t m_pts{};
+
+  std::atomic_int64_t m_written{};
+  std::atomic_bool m_running{};
+};
+
+}
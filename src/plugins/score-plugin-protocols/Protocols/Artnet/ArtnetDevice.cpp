@@ -3,16 +3,85 @@
 #include <QDebug>
 #if defined(OSSIA_PROTOCOL_ARTNET)
 #include "ArtnetDevice.hpp"
+#include "ArtnetOutput.hpp"
 #include "ArtnetSpecificSettings.hpp"
 
-#include <ossia/network/artnet/artnet_protocol.hpp>
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/network/base/protocol.hpp>
+#include <ossia/network/domain/domain.hpp>
 #include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/value/value_conversion.hpp>
+
+#include <algorithm>
 
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(Protocols::ArtnetDevice)
 
 namespace Protocols
 {
+namespace
+{
+// Exposes the channels of the universes as parameters:
+// /1 to /512 for a single universe, /<universe>/1 to /<universe>/512 else.
+class artnet_output_protocol final : public ossia::net::protocol_base
+{
+public:
+  explicit artnet_output_protocol(const ArtnetSpecificSettings& settings)
+      : m_settings{settings}, m_output{settings}
+  {
+    m_output.start();
+  }
+
+  ~artnet_output_protocol() override { m_output.stop(); }
+
+private:
+  bool pull(ossia::net::parameter_base&) override { return false; }
+
+  bool push(const ossia::net::parameter_base& param, const ossia::value& v) override
+  {
+    auto it = m_channels.find(&param);
+    if (it == m_channels.end())
+      return false;
+
+    const int val = std::clamp(ossia::convert<int>(v), 0, 255);
+    m_output.set(it->second.first, it->second.second, val);
+    return true;
+  }
+
+  bool push_raw(const ossia::net::full_parameter_data&) override { return false; }
+
+  bool observe(ossia::net::parameter_base&, bool) override { return false; }
+
+  bool update(ossia::net::node_base&) override { return true; }
+
+  void set_device(ossia::net::device_base& dev) override
+  {
+    auto& root = dev.get_root_node();
+    const int universes = m_output.universes();
+    m_channels.reserve(universes * ArtnetOutput::channels);
+
+    for (int u = 0; u < universes; u++)
+    {
+      ossia::net::node_base* parent = &root;
+      if (universes > 1)
+        parent = root.create_child(std::to_string(m_settings.universe + u));
+
+      for (int c = 0; c < ArtnetOutput::channels; c++)
+      {
+        auto node = parent->create_child(std::to_string(c + 1));
+        auto param = node->create_parameter(ossia::val_type::INT);
+        param->set_domain(ossia::make_domain(0, 255));
+        param->set_bounding(ossia::bounding_mode::CLIP);
+        m_channels.emplace(param, std::make_pair(u, c));
+      }
+    }
+  }
+
+  ArtnetSpecificSettings m_settings;
+  ArtnetOutput m_output;
+  ossia::fast_hash_map<const ossia::net::parameter_base*, std::pair<int, int>> m_channels;
+};
+}
 
 ArtnetDevice::ArtnetDevice(const Device::DeviceSettings& settings)
     : OwningDeviceInterface{settings}
@@ -33,10 +102,9 @@ bool ArtnetDevice::reconnect()
 
   try
   {
+    const auto& stgs = settings().deviceSpecificSettings.value<ArtnetSpecificSettings>();
     auto addr = std::make_unique<ossia::net::generic_device>(
-        std::make_unique<ossia::net::artnet_protocol>(
-            20), //  20 Hz update rate : TODO add control on widget
-        settings().name.toStdString());
+        std::make_unique<artnet_output_protocol>(stgs), settings().name.toStdString());
     m_dev = std::move(addr);
     deviceChanged(nullptr, m_dev.get());
   }
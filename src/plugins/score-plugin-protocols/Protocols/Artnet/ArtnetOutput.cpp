@@ -0,0 +1,201 @@
+#include <ossia/detail/config.hpp>
+#if defined(OSSIA_PROTOCOL_ARTNET)
+#include "ArtnetOutput.hpp"
+
+#include <QHostAddress>
+#include <QHostInfo>
+#include <QUdpSocket>
+
+#include <algorithm>
+
+namespace Protocols
+{
+namespace
+{
+struct ArtnetTarget
+{
+  QHostAddress host;
+  quint16 port{};
+};
+
+std::vector<ArtnetTarget> parseTargets(const QString& hosts)
+{
+  std::vector<ArtnetTarget> res;
+  for (QString str : hosts.split(','))
+  {
+    str = str.trimmed();
+    if (str.isEmpty())
+      continue;
+
+    quint16 port = ArtnetOutput::default_port;
+    if (str.count(':') == 1)
+    {
+      const auto parts = str.split(':');
+      str = parts[0];
+      port = parts[1].toUShort();
+    }
+
+    QHostAddress addr{str};
+    if (addr.isNull())
+    {
+      const auto info = QHostInfo::fromName(str).addresses();
+      if (info.isEmpty())
+        continue;
+      addr = info.front();
+    }
+    res.push_back({addr, port});
+  }
+
+  if (res.empty())
+    res.push_back({QHostAddress::Broadcast, ArtnetOutput::default_port});
+  return res;
+}
+
+void writeArtnetHeader(char* p, uint8_t opcode_hi) noexcept
+{
+  static constexpr char id[8] = "Art-Net";
+  std::copy_n(id, 8, p);
+
+  // OpCode is little-endian, protocol version big-endian
+  p[8] = 0x00;
+  p[9] = opcode_hi;
+  p[10] = 0;
+  p[11] = 14;
+}
+}
+
+struct ArtnetOutput::Sender
+{
+  explicit Sender(const QString& hosts) : targets{parseTargets(hosts)}
+  {
+    writeArtnetHeader(sync, 0x52); // OpSync
+  }
+
+  void send(const char* data, qint64 size)
+  {
+    for (const auto& t : targets)
+      socket.writeDatagram(data, size, t.host, t.port);
+  }
+
+  QUdpSocket socket;
+  std::vector<ArtnetTarget> targets;
+  char sync[14]{};
+};
+
+ArtnetOutput::ArtnetOutput(const ArtnetSpecificSettings& settings)
+    : m_settings{settings}
+    , m_universes(std::max(1, settings.universes))
+{
+  m_changed.reserve(m_universes.size());
+
+  for (std::size_t i = 0; i < m_universes.size(); i++)
+  {
+    auto& p = m_universes[i].packet;
+    writeArtnetHeader(p.data(), 0x50); // OpDmx
+
+    // Sequence and physical port
+    p[12] = 0;
+    p[13] = 0;
+
+    // 15-bit port-address: sub-net and universe, then net
+    const int addr = (m_settings.universe + i) & 0x7FFF;
+    p[14] = addr & 0xFF;
+    p[15] = (addr >> 8) & 0x7F;
+
+    p[16] = (channels >> 8) & 0xFF;
+    p[17] = channels & 0xFF;
+  }
+}
+
+ArtnetOutput::~ArtnetOutput()
+{
+  stop();
+}
+
+void ArtnetOutput::start()
+{
+  if (m_running)
+    return;
+
+  m_running = true;
+  m_thread = std::thread{[this] { run(); }};
+}
+
+void ArtnetOutput::stop()
+{
+  m_running = false;
+  if (m_thread.joinable())
+    m_thread.join();
+}
+
+void ArtnetOutput::set(int universe, int channel, uint8_t value) noexcept
+{
+  if (universe < 0 || universe >= universes() || channel < 0 || channel >= channels)
+    return;
+
+  std::lock_guard lck{m_mutex};
+  auto& u = m_universes[universe];
+  if (u.pending[channel] != value)
+  {
+    u.pending[channel] = value;
+    u.dirty = true;
+  }
+}
+
+void ArtnetOutput::tick(std::chrono::steady_clock::time_point now)
+{
+  static constexpr auto keep_alive = std::chrono::seconds(1);
+
+  // The socket belongs to the thread which ticks
+  if (!m_sender)
+    m_sender = std::make_unique<Sender>(m_settings.hosts);
+
+  {
+    std::lock_guard lck{m_mutex};
+    for (auto& u : m_universes)
+    {
+      if (u.dirty || now - u.lastSent >= keep_alive)
+      {
+        std::copy(u.pending.begin(), u.pending.end(), u.packet.begin() + header_size);
+        u.dirty = false;
+        m_changed.push_back(&u);
+      }
+    }
+  }
+
+  // The packets are only accessed by this thread
+  for (Universe* u : m_changed)
+  {
+    auto& seq = reinterpret_cast<uint8_t&>(u->packet[12]);
+    seq = (seq == 255) ? 1 : seq + 1;
+
+    m_sender->send(u->packet.data(), packet_size);
+    u->lastSent = now;
+  }
+
+  if (m_settings.sync && !m_changed.empty())
+    m_sender->send(m_sender->sync, sizeof(m_sender->sync));
+
+  m_changed.clear();
+}
+
+void ArtnetOutput::run()
+{
+  using clock = std::chrono::steady_clock;
+  const auto period = std::chrono::microseconds(1'000'000 / std::max(1, m_settings.rate));
+
+  auto next = clock::now();
+  while (m_running)
+  {
+    const auto now = clock::now();
+    tick(now);
+
+    // Do not try to catch up on missed ticks
+    next = std::max(next + period, now);
+    std::this_thread::sleep_until(next);
+  }
+
+  m_sender.reset();
+}
+}
+#endif
@@ -0,0 +1,85 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+#if defined(OSSIA_PROTOCOL_ARTNET)
+#include <Protocols/Artnet/ArtnetSpecificSettings.hpp>
+
+#include <score_plugin_protocols_export.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Protocols
+{
+/**
+ * @brief Sends DMX universes as Art-Net packets at a fixed rate.
+ *
+ * The channels can be set from any thread. A dedicated thread wakes up
+ * at the rate set in the settings, copies the universes which changed
+ * since the previous tick in their pre-built ArtDmx packet and sends them
+ * to all the targets, followed by an ArtSync packet if enabled.
+ *
+ * Universes which do not change are only sent again every second,
+ * so that the nodes keep their output.
+ */
+class SCORE_PLUGIN_PROTOCOLS_EXPORT ArtnetOutput
+{
+public:
+  static constexpr int channels = 512;
+  static constexpr int header_size = 18;
+  static constexpr int packet_size = header_size + channels;
+  static constexpr uint16_t default_port = 6454;
+
+  explicit ArtnetOutput(const ArtnetSpecificSettings& settings);
+  ~ArtnetOutput();
+
+  ArtnetOutput(const ArtnetOutput&) = delete;
+  ArtnetOutput& operator=(const ArtnetOutput&) = delete;
+
+  void start();
+  void stop();
+
+  int universes() const noexcept { return int(m_universes.size()); }
+
+  //! Can be called from any thread. The universe is an index in the
+  //! range of universes of the device, the channel is in [0; 511].
+  void set(int universe, int channel, uint8_t value) noexcept;
+
+  //! Sends the universes which changed, and the ones which were not sent
+  //! for a second. Called by the output thread at each period; when the
+  //! output is not started, the ticks can be driven by the caller.
+  void tick(std::chrono::steady_clock::time_point now);
+
+private:
+  struct Universe
+  {
+    std::array<uint8_t, channels> pending{};
+    bool dirty{true};
+
+    std::array<char, packet_size> packet{};
+    std::chrono::steady_clock::time_point lastSent{};
+  };
+
+  struct Sender;
+
+  void run();
+
+  ArtnetSpecificSettings m_settings;
+
+  std::mutex m_mutex;
+  std::vector<Universe> m_universes;
+
+  // Only accessed by the thread which ticks
+  std::unique_ptr<Sender> m_sender;
+  std::vector<Universe*> m_changed;
+
+  std::thread m_thread;
+  std::atomic_bool m_running{};
+};
+}
+#endif
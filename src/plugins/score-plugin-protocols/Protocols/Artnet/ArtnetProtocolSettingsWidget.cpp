@@ -5,7 +5,9 @@
 
 #include <State/Widgets/AddressFragmentLineEdit.hpp>
 
+#include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
 #include <QVariant>
 
 #include <wobjectimpl.h>
@@ -21,8 +23,30 @@ ArtnetProtocolSettingsWidget::ArtnetProtocolSettingsWidget(QWidget* parent)
   m_deviceNameEdit = new State::AddressFragmentLineEdit{this};
   m_deviceNameEdit->setText("Artnet");
 
+  m_rate = new QSpinBox{this};
+  m_rate->setRange(1, 1000);
+  m_rate->setSuffix(tr(" Hz"));
+  m_rate->setValue(ArtnetSpecificSettings{}.rate);
+
+  m_universe = new QSpinBox{this};
+  m_universe->setRange(0, 32767);
+
+  m_universes = new QSpinBox{this};
+  m_universes->setRange(1, 512);
+
+  m_hosts = new QLineEdit{this};
+  m_hosts->setPlaceholderText(tr("Broadcast"));
+  m_hosts->setToolTip(tr("Unicast targets separated by commas, e.g. 10.0.0.12, 10.0.0.13:6454"));
+
+  m_sync = new QCheckBox{this};
+
   auto layout = new QFormLayout;
   layout->addRow(tr("Name"), m_deviceNameEdit);
+  layout->addRow(tr("Rate"), m_rate);
+  layout->addRow(tr("First universe"), m_universe);
+  layout->addRow(tr("Universes"), m_universes);
+  layout->addRow(tr("Hosts"), m_hosts);
+  layout->addRow(tr("Send ArtSync"), m_sync);
 
   setLayout(layout);
 }
@@ -35,6 +59,11 @@ Device::DeviceSettings ArtnetProtocolSettingsWidget::getSettings() const
   s.name = m_deviceNameEdit->text();
 
   ArtnetSpecificSettings settings{};
+  settings.rate = m_rate->value();
+  settings.universe = m_universe->value();
+  settings.universes = m_universes->value();
+  settings.hosts = m_hosts->text();
+  settings.sync = m_sync->isChecked();
   s.deviceSpecificSettings = QVariant::fromValue(settings);
 
   return s;
@@ -43,6 +72,16 @@ Device::DeviceSettings ArtnetProtocolSettingsWidget::getSettings() const
 void ArtnetProtocolSettingsWidget::setSettings(const Device::DeviceSettings& settings)
 {
   m_deviceNameEdit->setText(settings.name);
+
+  if (settings.deviceSpecificSettings.canConvert<ArtnetSpecificSettings>())
+  {
+    const auto stgs = settings.deviceSpecificSettings.value<ArtnetSpecificSettings>();
+    m_rate->setValue(stgs.rate);
+    m_universe->setValue(stgs.universe);
+    m_universes->setValue(stgs.universes);
+    m_hosts->setText(stgs.hosts);
+    m_sync->setChecked(stgs.sync);
+  }
 }
 }
 #endif
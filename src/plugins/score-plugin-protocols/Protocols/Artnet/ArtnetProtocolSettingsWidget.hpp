@@ -7,7 +7,9 @@
 
 #include <verdigris>
 
+class QCheckBox;
 class QLineEdit;
+class QSpinBox;
 
 namespace Protocols
 {
@@ -24,6 +26,11 @@ public:
 
 protected:
   QLineEdit* m_deviceNameEdit{};
+  QSpinBox* m_rate{};
+  QSpinBox* m_universe{};
+  QSpinBox* m_universes{};
+  QLineEdit* m_hosts{};
+  QCheckBox* m_sync{};
 };
 }
 #endif
@@ -2,6 +2,8 @@
 #include <ossia/detail/config.hpp>
 #if defined(OSSIA_PROTOCOL_ARTNET)
 
+#include <QString>
+
 #include <verdigris>
 
 namespace Protocols
@@ -9,7 +11,19 @@ namespace Protocols
 
 struct ArtnetSpecificSettings
 {
-  int dummy;
+  //! Packets per second sent for each changed universe
+  int rate{44};
+
+  //! Port-address of the first universe, and number of universes
+  int universe{0};
+  int universes{1};
+
+  //! Unicast targets, e.g. "10.0.0.12, 10.0.0.13:6455".
+  //! Packets are broadcast when empty.
+  QString hosts;
+
+  //! Send an ArtSync packet after each batch of universes
+  bool sync{};
 };
 }
 
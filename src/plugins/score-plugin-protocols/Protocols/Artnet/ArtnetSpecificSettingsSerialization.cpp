@@ -5,25 +5,57 @@
 #include <score/serialization/DataStreamVisitor.hpp>
 #include <score/serialization/JSONVisitor.hpp>
 
+// The settings used to be saved as a single delimiter. They are now
+// preceded by a marker which cannot be mistaken for it.
+static constexpr int32_t artnet_settings_marker = 1;
+
 template <>
 void DataStreamReader::read(const Protocols::ArtnetSpecificSettings& n)
 {
+  m_stream << artnet_settings_marker;
+  m_stream << n.rate << n.universe << n.universes << n.hosts << n.sync;
   insertDelimiter();
 }
 
 template <>
 void DataStreamWriter::write(Protocols::ArtnetSpecificSettings& n)
 {
+  int32_t marker{};
+  m_stream >> marker;
+  if (marker != artnet_settings_marker)
+  {
+    // Older layout: the delimiter was just read, the settings keep their default values
+    SCORE_ASSERT(marker == int32_t(0xDEADBEEF));
+    return;
+  }
+
+  m_stream >> n.rate >> n.universe >> n.universes >> n.hosts >> n.sync;
   checkDelimiter();
 }
 
 template <>
 void JSONReader::read(const Protocols::ArtnetSpecificSettings& n)
 {
+  obj["Rate"] = n.rate;
+  obj["Universe"] = n.universe;
+  obj["Universes"] = n.universes;
+  obj["Hosts"] = n.hosts;
+  obj["Sync"] = n.sync;
 }
 
 template <>
 void JSONWriter::write(Protocols::ArtnetSpecificSettings& n)
 {
+  // Older documents did not save any setting
+  if (auto it = obj.tryGet("Rate"))
+    n.rate = it->toInt();
+  if (auto it = obj.tryGet("Universe"))
+    n.universe = it->toInt();
+  if (auto it = obj.tryGet("Universes"))
+    n.universes = it->toInt();
+  if (auto it = obj.tryGet("Hosts"))
+    n.hosts = it->toString();
+  if (auto it = obj.tryGet("Sync"))
+    n.sync = it->toBool();
 }
 #endif
@@ -0,0 +1,164 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "AsyncOutputProtocol.hpp"
+
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/parameter.hpp>
+
+#include <QDebug>
+
+
+namespace Protocols
+{
+AsyncOutputProtocol::AsyncOutputProtocol(
+    std::unique_ptr<ossia::net::protocol_base> protocol,
+    std::size_t capacity)
+    : m_protocol{std::move(protocol)}, m_capacity{capacity}, m_queue(capacity)
+{
+  m_running = true;
+  m_thread = std::thread{[this] { run(); }};
+}
+
+AsyncOutputProtocol::~AsyncOutputProtocol()
+{
+  stop();
+}
+
+void AsyncOutputProtocol::stop()
+{
+  if (!m_running.exchange(false))
+    return;
+
+  m_thread.join();
+  if (m_dropped > 0)
+    qDebug() << "AsyncOutputProtocol:" << m_dropped.load() << "values dropped";
+}
+
+AsyncOutputProtocol::Statistics AsyncOutputProtocol::statistics() const noexcept
+{
+  return {
+      m_pushed, m_sent, m_coalesced, m_dropped, std::chrono::microseconds{m_maxLatency.load()}};
+}
+
+bool AsyncOutputProtocol::pull(ossia::net::parameter_base& p)
+{
+  return m_protocol->pull(p);
+}
+
+bool AsyncOutputProtocol::push(const ossia::net::parameter_base& p, const ossia::value& v)
+{
+  // Never allocates: the queue is full when the sender cannot keep up
+  if (!m_queue.try_enqueue(Item{&p, v, clock::now(), m_sequence++}))
+  {
+    m_dropped++;
+    return false;
+  }
+
+  m_pushed++;
+  return true;
+}
+
+bool AsyncOutputProtocol::push_raw(const ossia::net::full_parameter_data& p)
+{
+  return m_protocol->push_raw(p);
+}
+
+bool AsyncOutputProtocol::observe(ossia::net::parameter_base& p, bool b)
+{
+  return m_protocol->observe(p, b);
+}
+
+bool AsyncOutputProtocol::update(ossia::net::node_base& n)
+{
+  return m_protocol->update(n);
+}
+
+void AsyncOutputProtocol::set_device(ossia::net::device_base& dev)
+{
+  // The device owns the protocol: the connection lasts as long as both
+  dev.on_parameter_removing.connect<&AsyncOutputProtocol::on_parameter_removing>(this);
+  m_protocol->set_device(dev);
+}
+
+void AsyncOutputProtocol::on_parameter_removing(const ossia::net::parameter_base& p)
+{
+  std::lock_guard lck{m_sendMutex};
+
+  // The values queued until now are sent without waiting for the sender,
+  // except the ones of the parameter which is going away.
+  m_removed.emplace_back(&p, m_sequence.load());
+
+  if (m_drained.empty())
+    m_drained.resize(m_capacity);
+  while (const auto count = m_queue.try_dequeue_bulk(m_drained.begin(), m_drained.size()))
+  {
+    if (m_running)
+      send(m_drained, count);
+  }
+
+  // The sender may also have taken values before the parameter was removed:
+  // the entry is kept until it has sent them.
+  if (!m_running)
+    m_removed.clear();
+}
+
+void AsyncOutputProtocol::set_logger(const ossia::net::network_logger& l)
+{
+  m_protocol->set_logger(l);
+}
+
+void AsyncOutputProtocol::send(std::vector<Item>& items, std::size_t count)
+{
+  // Keep the last value of each parameter, in the order they were pushed
+  m_seen.clear();
+  m_latest.clear();
+  for (std::size_t i = count; i-- > 0;)
+  {
+    if (m_seen.try_emplace(items[i].parameter, i).second)
+      m_latest.push_back(i);
+  }
+  m_coalesced += count - m_latest.size();
+
+  for (auto it = m_latest.rbegin(); it != m_latest.rend(); ++it)
+  {
+    auto& item = items[*it];
+
+    // The value was pushed before its parameter was removed
+    const bool removed = ossia::any_of(m_removed, [&](const auto& r) {
+      return r.first == item.parameter && item.sequence < r.second;
+    });
+    if (removed)
+      continue;
+
+    m_protocol->push(*item.parameter, item.value);
+    m_sent++;
+
+    const int64_t latency
+        = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - item.time).count();
+    if (latency > m_maxLatency)
+      m_maxLatency = latency;
+  }
+
+  for (std::size_t i = 0; i < count; i++)
+    items[i].value = ossia::value{};
+}
+
+void AsyncOutputProtocol::run()
+{
+  std::vector<Item> items(m_capacity);
+
+  while (m_running)
+  {
+    const auto count
+        = m_queue.wait_dequeue_bulk_timed(items.begin(), items.size(), std::chrono::milliseconds(50));
+
+    std::lock_guard lck{m_sendMutex};
+    if (count > 0)
+      send(items, count);
+
+    // The values taken before a parameter was removed are now handled
+    m_removed.clear();
+  }
+}
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/network/base/protocol.hpp>
+#include <ossia/network/value/value.hpp>
+
+#include <blockingconcurrentqueue.h>
+#include <score_plugin_protocols_export.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Protocols
+{
+/**
+ * @brief Sends the values pushed to a protocol from a thread of its own.
+ *
+ * Pushing a value, e.g. from the execution thread, only puts it in a
+ * bounded lock-free queue: slow protocols such as HTTP, serial ports or
+ * websockets can no longer stall the audio thread.
+ *
+ * The sender thread takes everything in the queue at once and only sends
+ * the latest value of each parameter: a value never waits for more than
+ * one pass over the parameters which changed before it. Values which do
+ * not fit in the queue are dropped and counted.
+ *
+ * When a parameter is removed from the device, the values queued until
+ * then are sent right away, except the ones of that parameter: the queue
+ * never refers to a parameter which does not exist anymore.
+ */
+class SCORE_PLUGIN_PROTOCOLS_EXPORT AsyncOutputProtocol final : public ossia::net::protocol_base
+{
+public:
+  static constexpr std::size_t default_capacity = 4096;
+
+  struct Statistics
+  {
+    uint64_t pushed{};
+    uint64_t sent{};
+    uint64_t coalesced{};
+    uint64_t dropped{};
+    std::chrono::microseconds maxLatency{};
+  };
+
+  explicit AsyncOutputProtocol(
+      std::unique_ptr<ossia::net::protocol_base> protocol,
+      std::size_t capacity = default_capacity);
+  ~AsyncOutputProtocol() override;
+
+  ossia::net::protocol_base& protocol() const noexcept { return *m_protocol; }
+
+  void stop();
+
+  Statistics statistics() const noexcept;
+
+private:
+  bool pull(ossia::net::parameter_base& p) override;
+  bool push(const ossia::net::parameter_base& p, const ossia::value& v) override;
+  bool push_raw(const ossia::net::full_parameter_data& p) override;
+  bool observe(ossia::net::parameter_base& p, bool b) override;
+  bool update(ossia::net::node_base& n) override;
+  void set_device(ossia::net::device_base& dev) override;
+  void set_logger(const ossia::net::network_logger& l) override;
+
+  using clock = std::chrono::steady_clock;
+  struct Item
+  {
+    const ossia::net::parameter_base* parameter{};
+    ossia::value value;
+    clock::time_point time;
+    uint64_t sequence{};
+  };
+
+  void run();
+  void on_parameter_removing(const ossia::net::parameter_base& p);
+
+  //! Must be called with m_sendMutex locked
+  void send(std::vector<Item>& items, std::size_t count);
+
+  std::unique_ptr<ossia::net::protocol_base> m_protocol;
+  const std::size_t m_capacity{};
+  moodycamel::BlockingConcurrentQueue<Item> m_queue;
+  std::atomic<uint64_t> m_sequence{};
+
+  // Held while values are sent, by the sender or by a thread removing a parameter
+  std::mutex m_sendMutex;
+  // Parameters removed, and the sequence number of the next value at that time
+  std::vector<std::pair<const ossia::net::parameter_base*, uint64_t>> m_removed;
+  std::vector<Item> m_drained;
+  std::vector<std::size_t> m_latest;
+  ossia::fast_hash_map<const ossia::net::parameter_base*, std::size_t> m_seen;
+
+  std::atomic<uint64_t> m_pushed{};
+  std::atomic<uint64_t> m_sent{};
+  std::atomic<uint64_t> m_coalesced{};
+  std::atomic<uint64_t> m_dropped{};
+  std::atomic<int64_t> m_maxLatency{};
+
+  std::thread m_thread;
+  std::atomic_bool m_running{};
+};
+}
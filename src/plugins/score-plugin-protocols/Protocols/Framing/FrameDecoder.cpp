@@ -0,0 +1,529 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "FrameDecoder.hpp"
+
+#include <ossia/network/value/value_conversion.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace Protocols
+{
+namespace
+{
+template <typename T>
+using unsigned_of = std::conditional_t<
+    sizeof(T) == 1,
+    uint8_t,
+    std::conditional_t<
+        sizeof(T) == 2,
+        uint16_t,
+        std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+template <typename T>
+T readNumber(const char* data, bool bigEndian) noexcept
+{
+  using U = unsigned_of<T>;
+  U u{};
+  for (std::size_t i = 0; i < sizeof(T); i++)
+  {
+    const auto byte = uint8_t(data[bigEndian ? i : sizeof(T) - 1 - i]);
+    u = U((uint64_t(u) << 8) | byte);
+  }
+
+  T res;
+  std::memcpy(&res, &u, sizeof(T));
+  return res;
+}
+
+template <typename T>
+ossia::value makeValue(T v, double scale) noexcept
+{
+  if constexpr (std::is_integral_v<T>)
+  {
+    if (scale == 1.)
+      return int(v);
+  }
+  return float(v * scale);
+}
+
+ossia::value readField(FrameField::Type t, const char* data, bool bigEndian, double scale)
+{
+  switch (t)
+  {
+    case FrameField::Int8:
+      return makeValue(readNumber<int8_t>(data, bigEndian), scale);
+    case FrameField::UInt8:
+      return makeValue(readNumber<uint8_t>(data, bigEndian), scale);
+    case FrameField::Int16:
+      return makeValue(readNumber<int16_t>(data, bigEndian), scale);
+    case FrameField::UInt16:
+      return makeValue(readNumber<uint16_t>(data, bigEndian), scale);
+    case FrameField::Int32:
+      return makeValue(readNumber<int32_t>(data, bigEndian), scale);
+    case FrameField::UInt32:
+      return makeValue(readNumber<uint32_t>(data, bigEndian), scale);
+    case FrameField::Float32:
+      return makeValue(readNumber<float>(data, bigEndian), scale);
+    case FrameField::Float64:
+      return makeValue(readNumber<double>(data, bigEndian), scale);
+    case FrameField::String:
+      break;
+  }
+  return {};
+}
+
+template <typename T>
+void writeNumber(T v, bool bigEndian, std::string& out)
+{
+  unsigned_of<T> u;
+  std::memcpy(&u, &v, sizeof(T));
+  for (std::size_t i = 0; i < sizeof(T); i++)
+  {
+    const std::size_t byte = bigEndian ? sizeof(T) - 1 - i : i;
+    out.push_back(char(uint64_t(u) >> (8 * byte)));
+  }
+}
+
+template <typename T>
+void writeInteger(double v, bool bigEndian, std::string& out)
+{
+  writeNumber(T(std::llround(v)), bigEndian, out);
+}
+
+void writeField(FrameField::Type t, double v, bool bigEndian, std::string& out)
+{
+  switch (t)
+  {
+    case FrameField::Int8:
+      return writeInteger<int8_t>(v, bigEndian, out);
+    case FrameField::UInt8:
+      return writeInteger<uint8_t>(v, bigEndian, out);
+    case FrameField::Int16:
+      return writeInteger<int16_t>(v, bigEndian, out);
+    case FrameField::UInt16:
+      return writeInteger<uint16_t>(v, bigEndian, out);
+    case FrameField::Int32:
+      return writeInteger<int32_t>(v, bigEndian, out);
+    case FrameField::UInt32:
+      return writeInteger<uint32_t>(v, bigEndian, out);
+    case FrameField::Float32:
+      return writeNumber(float(v), bigEndian, out);
+    case FrameField::Float64:
+      return writeNumber(double(v), bigEndian, out);
+    case FrameField::String:
+      break;
+  }
+}
+
+//! Decodes a COBS block, without its trailing zero
+bool unstuff(const std::string& block, std::string& out)
+{
+  const std::size_t n = block.size();
+  std::size_t i = 0;
+  while (i < n)
+  {
+    const auto code = uint8_t(block[i++]);
+    if (code == 0 || i + code - 1 > n)
+      return false;
+
+    out.append(block, i, code - 1);
+    i += code - 1;
+    if (code < 0xFF && i < n)
+      out.push_back('\0');
+  }
+  return true;
+}
+}
+
+FrameDecoder::FrameDecoder(FramingSpec spec) : m_spec{std::move(spec)}
+{
+  if (m_spec.delimiter.empty())
+    m_spec.delimiter = "\n";
+  if (m_spec.lengthSize != 1 && m_spec.lengthSize != 2 && m_spec.lengthSize != 4)
+    m_spec.lengthSize = 1;
+
+  m_buffer.reserve(m_spec.maxSize * 2);
+  m_frame.reserve(m_spec.maxSize);
+  m_block.reserve(m_spec.maxSize);
+}
+
+int FrameDecoder::fieldSize(FrameField::Type t) noexcept
+{
+  switch (t)
+  {
+    case FrameField::Int8:
+    case FrameField::UInt8:
+      return 1;
+    case FrameField::Int16:
+    case FrameField::UInt16:
+      return 2;
+    case FrameField::Int32:
+    case FrameField::UInt32:
+    case FrameField::Float32:
+      return 4;
+    case FrameField::Float64:
+      return 8;
+    case FrameField::String:
+      return 0;
+  }
+  return 0;
+}
+
+std::optional<std::pair<std::size_t, std::size_t>> FrameDecoder::nextFrame(std::size_t& pos)
+{
+  if (m_spec.framing == Framing::Delimiter)
+  {
+    while (pos < m_buffer.size())
+    {
+      const auto end = m_buffer.find(m_spec.delimiter, pos);
+      if (end == std::string::npos)
+        return std::nullopt;
+
+      const auto start = pos;
+      pos = end + m_spec.delimiter.size();
+
+      // e.g. "\r\n" line endings when only "\n" is the delimiter
+      if (end > start)
+        return std::make_pair(start, end - start);
+    }
+    return std::nullopt;
+  }
+  else
+  {
+    const std::size_t header = m_spec.lengthSize;
+    if (m_buffer.size() - pos < header)
+      return std::nullopt;
+
+    const char* data = m_buffer.data() + pos;
+    std::size_t size{};
+    switch (header)
+    {
+      case 1:
+        size = readNumber<uint8_t>(data, m_spec.bigEndian);
+        break;
+      case 2:
+        size = readNumber<uint16_t>(data, m_spec.bigEndian);
+        break;
+      case 4:
+        size = readNumber<uint32_t>(data, m_spec.bigEndian);
+        break;
+    }
+
+    if (size > std::size_t(m_spec.maxSize))
+    {
+      // We lost track of the frames: start again from the next chunk
+      m_errors++;
+      pos = m_buffer.size();
+      return std::nullopt;
+    }
+
+    if (m_buffer.size() - pos < header + size)
+      return std::nullopt;
+
+    const auto start = pos + header;
+    pos = start + size;
+    return std::make_pair(start, size);
+  }
+}
+
+bool FrameDecoder::stuffedByte(uint8_t c)
+{
+  if (m_spec.framing == Framing::SLIP)
+  {
+    constexpr uint8_t end = 0xC0;
+    constexpr uint8_t esc = 0xDB;
+    constexpr uint8_t esc_end = 0xDC;
+    constexpr uint8_t esc_esc = 0xDD;
+
+    if (c == end)
+    {
+      m_escape = false;
+      if (std::exchange(m_discard, false))
+        return false;
+      return !m_frame.empty();
+    }
+    if (m_discard)
+      return false;
+
+    if (m_escape)
+    {
+      m_escape = false;
+      if (c == esc_end)
+        c = end;
+      else if (c == esc_esc)
+        c = esc;
+      else
+      {
+        m_errors++;
+        m_discard = true;
+        m_frame.clear();
+        return false;
+      }
+    }
+    else if (c == esc)
+    {
+      m_escape = true;
+      return false;
+    }
+
+    m_frame.push_back(char(c));
+    if (m_frame.size() > std::size_t(m_spec.maxSize))
+    {
+      m_errors++;
+      m_discard = true;
+      m_frame.clear();
+    }
+    return false;
+  }
+  else
+  {
+    if (c == 0)
+    {
+      if (std::exchange(m_discard, false) || m_block.empty())
+      {
+        m_block.clear();
+        return false;
+      }
+
+      const bool ok = unstuff(m_block, m_frame);
+      m_block.clear();
+      if (!ok)
+      {
+        m_errors++;
+        m_frame.clear();
+        return false;
+      }
+      return !m_frame.empty();
+    }
+    if (m_discard)
+      return false;
+
+    m_block.push_back(char(c));
+
+    // One overhead byte every 254 bytes
+    if (m_block.size() > std::size_t(m_spec.maxSize + m_spec.maxSize / 254 + 1))
+    {
+      m_errors++;
+      m_discard = true;
+      m_block.clear();
+    }
+    return false;
+  }
+}
+
+bool FrameDecoder::decode(const char* frame, std::size_t size, std::vector<ossia::value>& values)
+{
+  values.clear();
+  const bool ok = m_spec.separator ? decodeText(frame, size, values)
+                                   : decodeBinary(frame, size, values);
+  if (!ok)
+    m_errors++;
+  return ok;
+}
+
+bool FrameDecoder::decodeBinary(
+    const char* frame,
+    std::size_t size,
+    std::vector<ossia::value>& values) const
+{
+  std::size_t pos = 0;
+  for (const auto& field : m_spec.fields)
+  {
+    const std::size_t offset = field.offset >= 0 ? std::size_t(field.offset) : pos;
+    if (field.type == FrameField::String)
+    {
+      if (offset > size)
+        return false;
+
+      // Up to the next NUL or the end of the frame
+      const auto begin = frame + offset;
+      const auto end = static_cast<const char*>(std::memchr(begin, 0, size - offset));
+      const std::size_t len = end ? std::size_t(end - begin) : size - offset;
+      values.emplace_back(std::string(begin, len));
+      pos = offset + len + 1;
+    }
+    else
+    {
+      const std::size_t bytes = fieldSize(field.type);
+      if (offset + bytes > size)
+        return false;
+
+      values.push_back(readField(field.type, frame + offset, m_spec.bigEndian, field.scale));
+      pos = offset + bytes;
+    }
+  }
+  return true;
+}
+
+bool FrameDecoder::decodeText(
+    const char* frame,
+    std::size_t size,
+    std::vector<ossia::value>& values) const
+{
+  const char* const end = frame + size;
+  const char* token = frame;
+  char buf[64];
+
+  for (const auto& field : m_spec.fields)
+  {
+    if (token > end)
+      return false;
+
+    auto sep = static_cast<const char*>(std::memchr(token, m_spec.separator, end - token));
+    if (!sep)
+      sep = end;
+
+    // Trailing "\r" of "\r\n" line endings
+    const char* token_end = sep;
+    while (token_end > token && (token_end[-1] == '\r' || token_end[-1] == ' '))
+      token_end--;
+    const std::size_t len = token_end - token;
+
+    if (field.type == FrameField::String)
+    {
+      values.emplace_back(std::string(token, len));
+    }
+    else
+    {
+      if (len == 0 || len >= sizeof(buf))
+        return false;
+
+      std::memcpy(buf, token, len);
+      buf[len] = '\0';
+
+      char* parsed_end{};
+      if (field.isInteger())
+      {
+        const long v = std::strtol(buf, &parsed_end, 10);
+        values.emplace_back(int(v));
+      }
+      else
+      {
+        const double v = std::strtod(buf, &parsed_end);
+        values.emplace_back(float(v * field.scale));
+      }
+
+      if (parsed_end == buf)
+        return false;
+    }
+
+    token = sep + 1;
+  }
+  return true;
+}
+
+void appendFrame(const FramingSpec& spec, const char* payload, std::size_t size, std::string& out)
+{
+  switch (spec.framing)
+  {
+    case Framing::Delimiter:
+      out.append(payload, size);
+      out += spec.delimiter.empty() ? "\n" : spec.delimiter;
+      break;
+
+    case Framing::LengthPrefixed:
+      switch (spec.lengthSize)
+      {
+        case 2:
+          writeNumber(uint16_t(size), spec.bigEndian, out);
+          break;
+        case 4:
+          writeNumber(uint32_t(size), spec.bigEndian, out);
+          break;
+        default:
+          writeNumber(uint8_t(size), spec.bigEndian, out);
+          break;
+      }
+      out.append(payload, size);
+      break;
+
+    case Framing::SLIP:
+      for (std::size_t i = 0; i < size; i++)
+      {
+        const auto c = uint8_t(payload[i]);
+        if (c == 0xC0)
+          out += "\xDB\xDC";
+        else if (c == 0xDB)
+          out += "\xDB\xDD";
+        else
+          out.push_back(char(c));
+      }
+      out.push_back(char(0xC0));
+      break;
+
+    case Framing::COBS:
+    {
+      // Each block starts with the distance to the next zero
+      std::size_t code_pos = out.size();
+      out.push_back('\0');
+      uint8_t code = 1;
+      for (std::size_t i = 0; i < size; i++)
+      {
+        const char c = payload[i];
+        if (c != 0)
+        {
+          out.push_back(c);
+          code++;
+        }
+        if (c == 0 || code == 0xFF)
+        {
+          out[code_pos] = char(code);
+          code_pos = out.size();
+          out.push_back('\0');
+          code = 1;
+        }
+      }
+      out[code_pos] = char(code);
+      out.push_back('\0');
+      break;
+    }
+  }
+}
+
+bool encodeFrame(
+    const FramingSpec& spec,
+    const FrameField& output,
+    const ossia::value& v,
+    std::string& out)
+{
+  std::string payload = output.header;
+  if (output.type == FrameField::String)
+  {
+    if (spec.separator && !payload.empty())
+      payload.push_back(spec.separator);
+    payload += ossia::convert<std::string>(v);
+  }
+  else if (spec.separator)
+  {
+    if (!payload.empty())
+      payload.push_back(spec.separator);
+
+    // Same formats as the ones which are parsed
+    const double num = ossia::convert<double>(v);
+    if (output.isInteger())
+    {
+      payload += std::to_string(std::llround(num));
+    }
+    else
+    {
+      char buf[64];
+      std::snprintf(buf, sizeof(buf), "%g", num / output.scale);
+      payload += buf;
+    }
+  }
+  else
+  {
+    writeField(output.type, ossia::convert<double>(v) / output.scale, spec.bigEndian, payload);
+  }
+
+  if (payload.size() > std::size_t(spec.maxSize))
+    return false;
+
+  appendFrame(spec, payload.data(), payload.size(), out);
+  return true;
+}
+}
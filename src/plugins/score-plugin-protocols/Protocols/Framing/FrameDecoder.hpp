@@ -0,0 +1,196 @@
+#pragma once
+#include <ossia/network/value/value.hpp>
+
+#include <score_plugin_protocols_export.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Protocols
+{
+//! How the frames are delimited in a stream of bytes
+enum class Framing : int8_t
+{
+  Delimiter,      //!< Each frame ends with a delimiter, e.g. "\n"
+  LengthPrefixed, //!< Each frame starts with its size in bytes
+  SLIP,           //!< RFC 1055
+  COBS            //!< Consistent overhead byte stuffing, frames end with 0
+};
+
+struct FrameField
+{
+  enum Type : int8_t
+  {
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64,
+    String
+  };
+
+  //! Parameter which receives the field; may be empty if only the script uses it
+  std::string address;
+  Type type{Float32};
+
+  //! Binary layouts: position in the frame, -1 to follow the previous field
+  int offset{-1};
+
+  //! Numeric fields are multiplied by this, e.g. to convert raw sensor units
+  double scale{1.};
+
+  //! Outputs: bytes sent before the value, e.g. the command of a message
+  std::string header;
+
+  //! Integer fields which are not scaled give int values, the others floats
+  bool isInteger() const noexcept { return type < Float32 && scale == 1.; }
+};
+
+/**
+ * @brief Layout of the packets sent by a device.
+ *
+ * Declared in the "framing" property of the QML script of a device, e.g.
+ * @code
+ * property var framing: ({
+ *   type: "cobs",
+ *   endianness: "little",
+ *   layout: [
+ *     { address: "/accel/x", type: "i16", scale: 0.001 },
+ *     { address: "/accel/y", type: "i16", scale: 0.001 }
+ *   ],
+ *   outputs: [
+ *     { address: "/led", type: "u8", header: "L" }
+ *   ]
+ * })
+ * @endcode
+ *
+ * Binary frames are read according to the offsets and sizes of the fields.
+ * If a separator is set, frames are text instead: they are split on the
+ * separator and each token is parsed according to the type of its field.
+ *
+ * Each output is a parameter which can be written to: a value sent to it
+ * goes in a frame of its own, after the header of the output, with the
+ * same framing and encoding as the frames which are read.
+ */
+struct FramingSpec
+{
+  Framing framing{Framing::Delimiter};
+  std::string delimiter{"\n"};
+  int lengthSize{1};
+  bool bigEndian{};
+  char separator{};
+  int maxSize{4096};
+  std::vector<FrameField> fields;
+  std::vector<FrameField> outputs;
+
+  //! Transport options
+  int baudRate{115200};
+  std::string url;
+  int interval{1000};
+};
+
+/**
+ * @brief Splits a stream of bytes in frames and decodes their fields.
+ *
+ * Bytes can be fed in chunks of any size; incomplete frames are kept until
+ * the next call. Frames larger than the maximum size are dropped and
+ * counted as errors.
+ */
+class SCORE_PLUGIN_PROTOCOLS_EXPORT FrameDecoder
+{
+public:
+  explicit FrameDecoder(FramingSpec spec);
+
+  const FramingSpec& spec() const noexcept { return m_spec; }
+
+  //! Calls f(const char* data, std::size_t size) for each complete frame
+  template <typename F>
+  void feed(const char* data, std::size_t size, F&& f)
+  {
+    switch (m_spec.framing)
+    {
+      case Framing::Delimiter:
+      case Framing::LengthPrefixed:
+      {
+        m_buffer.append(data, size);
+        std::size_t pos = 0;
+        while (auto frame = nextFrame(pos))
+        {
+          f(m_buffer.data() + frame->first, frame->second);
+          m_frames++;
+        }
+        m_buffer.erase(0, pos);
+        if (m_buffer.size() > std::size_t(m_spec.maxSize + m_spec.lengthSize)
+                                  + m_spec.delimiter.size())
+        {
+          m_buffer.clear();
+          m_errors++;
+        }
+        break;
+      }
+
+      case Framing::SLIP:
+      case Framing::COBS:
+      {
+        for (std::size_t i = 0; i < size; i++)
+        {
+          if (stuffedByte(uint8_t(data[i])))
+          {
+            f(m_frame.data(), m_frame.size());
+            m_frames++;
+            m_frame.clear();
+          }
+        }
+        break;
+      }
+    }
+  }
+
+  //! Decodes the fields of a frame; returns false if it does not match the layout
+  bool decode(const char* frame, std::size_t size, std::vector<ossia::value>& values);
+
+  uint64_t frames() const noexcept { return m_frames; }
+  uint64_t errors() const noexcept { return m_errors; }
+
+  static int fieldSize(FrameField::Type t) noexcept;
+
+private:
+  //! Offset and size of the next complete frame in the buffer, from pos
+  std::optional<std::pair<std::size_t, std::size_t>> nextFrame(std::size_t& pos);
+  bool stuffedByte(uint8_t c);
+
+  bool decodeBinary(const char* frame, std::size_t size, std::vector<ossia::value>& values) const;
+  bool decodeText(const char* frame, std::size_t size, std::vector<ossia::value>& values) const;
+
+  FramingSpec m_spec;
+
+  // Delimiter and length-prefixed frames are read in place from the buffer
+  std::string m_buffer;
+  // SLIP and COBS frames are unstuffed byte by byte
+  std::string m_frame;
+  std::string m_block;
+  bool m_escape{};
+  bool m_discard{};
+
+  uint64_t m_frames{};
+  uint64_t m_errors{};
+};
+
+//! Appends a payload to out, delimited or stuffed according to the framing of the spec
+SCORE_PLUGIN_PROTOCOLS_EXPORT
+void appendFrame(const FramingSpec& spec, const char* payload, std::size_t size, std::string& out);
+
+//! Appends the frame which sends a value to an output; returns false if it is too large
+SCORE_PLUGIN_PROTOCOLS_EXPORT
+bool encodeFrame(
+    const FramingSpec& spec,
+    const FrameField& output,
+    const ossia::value& v,
+    std::string& out);
+}
@@ -0,0 +1,339 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "FramedProtocol.hpp"
+
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/node.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/parameter.hpp>
+
+#include <ossia-qt/js_utilities.hpp>
+
+#include <QHash>
+#include <QJSValueIterator>
+#include <QQmlComponent>
+#include <QQmlEngine>
+
+#include <wobjectimpl.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+W_OBJECT_IMPL(Protocols::FramedProtocol)
+
+namespace Protocols
+{
+namespace
+{
+FrameField::Type fieldType(const QString& str)
+{
+  static const std::pair<QLatin1String, FrameField::Type> types[]{
+      {QLatin1String("i8"), FrameField::Int8},
+      {QLatin1String("u8"), FrameField::UInt8},
+      {QLatin1String("i16"), FrameField::Int16},
+      {QLatin1String("u16"), FrameField::UInt16},
+      {QLatin1String("i32"), FrameField::Int32},
+      {QLatin1String("u32"), FrameField::UInt32},
+      {QLatin1String("f32"), FrameField::Float32},
+      {QLatin1String("f64"), FrameField::Float64},
+      {QLatin1String("string"), FrameField::String}};
+
+  for (const auto& [name, type] : types)
+    if (str == name)
+      return type;
+  return FrameField::Float32;
+}
+
+Framing framingType(const QString& str)
+{
+  if (str == QLatin1String("length"))
+    return Framing::LengthPrefixed;
+  if (str == QLatin1String("slip"))
+    return Framing::SLIP;
+  if (str == QLatin1String("cobs"))
+    return Framing::COBS;
+  return Framing::Delimiter;
+}
+
+ossia::val_type valueType(const FrameField& field)
+{
+  return field.type == FrameField::String ? ossia::val_type::STRING
+         : field.isInteger()              ? ossia::val_type::INT
+                                          : ossia::val_type::FLOAT;
+}
+
+FrameField readField(const QJSValue& field)
+{
+  FrameField f;
+  f.address = field.property("address").toString().toStdString();
+  f.type = fieldType(field.property("type").toString().toLower());
+  if (auto v = field.property("offset"); v.isNumber())
+    f.offset = v.toInt();
+  if (auto v = field.property("scale"); v.isNumber())
+    f.scale = v.toNumber();
+  if (auto v = field.property("header"); v.isString())
+    f.header = v.toString().toLatin1().toStdString();
+  return f;
+}
+
+std::vector<FrameField> readFields(const QJSValue& array)
+{
+  std::vector<FrameField> fields;
+  QJSValueIterator it(array);
+  while (it.hasNext())
+  {
+    it.next();
+    if (const auto field = it.value(); field.isObject())
+      fields.push_back(readField(field));
+  }
+  return fields;
+}
+
+std::optional<FramingSpec> parseFramingSpec(const QByteArray& code)
+{
+  QQmlEngine engine;
+  QQmlComponent component{&engine};
+  component.setData(code, QUrl{});
+  if (!component.isReady())
+    return std::nullopt;
+
+  std::unique_ptr<QObject> object{component.create()};
+  if (!object)
+    return std::nullopt;
+
+  const auto framing = object->property("framing").value<QJSValue>();
+  if (!framing.isObject())
+    return std::nullopt;
+
+  FramingSpec spec;
+  spec.framing = framingType(framing.property("type").toString().toLower());
+  if (auto v = framing.property("delimiter"); v.isString())
+    spec.delimiter = v.toString().toStdString();
+  if (auto v = framing.property("lengthSize"); v.isNumber())
+    spec.lengthSize = v.toInt();
+  if (auto v = framing.property("endianness"); v.isString())
+    spec.bigEndian = v.toString() == QLatin1String("big");
+  if (auto v = framing.property("separator"); v.isString() && !v.toString().isEmpty())
+    spec.separator = v.toString().toLatin1().front();
+  if (auto v = framing.property("maxSize"); v.isNumber())
+    spec.maxSize = v.toInt();
+  if (auto v = framing.property("baudRate"); v.isNumber())
+    spec.baudRate = v.toInt();
+  if (auto v = framing.property("url"); v.isString())
+    spec.url = v.toString().toStdString();
+  if (auto v = framing.property("interval"); v.isNumber())
+    spec.interval = v.toInt();
+
+  spec.fields = readFields(framing.property("layout"));
+  spec.outputs = readFields(framing.property("outputs"));
+  return spec;
+}
+}
+
+std::optional<FramingSpec> readFramingSpec(const QByteArray& code)
+{
+  // Evaluating the script needs a whole QML engine: the devices
+  // are reconnected with the same scripts most of the time.
+  static std::mutex mutex;
+  static QHash<QByteArray, std::optional<FramingSpec>> specs;
+
+  std::lock_guard lock{mutex};
+  if (auto it = specs.constFind(code); it != specs.constEnd())
+    return *it;
+
+  if (specs.size() >= 16)
+    specs.clear();
+  auto spec = parseFramingSpec(code);
+  specs.insert(code, spec);
+  return spec;
+}
+
+FramedProtocol::FramedProtocol(FramingSpec spec, const QByteArray& code)
+    : m_code{code}, m_decoder{std::move(spec)}
+{
+  this->moveToThread(&m_thread);
+  m_thread.start();
+}
+
+FramedProtocol::~FramedProtocol()
+{
+  stop();
+}
+
+void FramedProtocol::stop()
+{
+  if (!m_thread.isRunning())
+    return;
+
+  QMetaObject::invokeMethod(
+      this,
+      [this] {
+        close();
+        delete m_engine;
+        m_engine = nullptr;
+      },
+      Qt::BlockingQueuedConnection);
+
+  m_thread.exit();
+  m_thread.wait();
+}
+
+FramedProtocol::Statistics FramedProtocol::statistics() const noexcept
+{
+  return {m_bytes, m_frames, m_errors};
+}
+
+bool FramedProtocol::pull(ossia::net::parameter_base&)
+{
+  return false;
+}
+
+bool FramedProtocol::push(const ossia::net::parameter_base& p, const ossia::value& v)
+{
+  // The other parameters only reflect what the device sends
+  auto it = ossia::find_if(m_outputs, [&](const auto& output) { return output.first == &p; });
+  if (it == m_outputs.end())
+    return false;
+
+  if (p.filter_value(v))
+    return false;
+
+  std::string frame;
+  if (!encodeFrame(spec(), *it->second, v, frame))
+    return false;
+
+  QMetaObject::invokeMethod(
+      this,
+      [this, frame = std::move(frame)] { write(frame.data(), frame.size()); },
+      Qt::QueuedConnection);
+  return true;
+}
+
+bool FramedProtocol::push_raw(const ossia::net::full_parameter_data&)
+{
+  return false;
+}
+
+bool FramedProtocol::observe(ossia::net::parameter_base&, bool)
+{
+  return false;
+}
+
+bool FramedProtocol::update(ossia::net::node_base&)
+{
+  return true;
+}
+
+void FramedProtocol::set_device(ossia::net::device_base& dev)
+{
+  m_device = &dev;
+
+  auto& root = dev.get_root_node();
+  for (const auto& field : spec().fields)
+  {
+    ossia::net::parameter_base* param{};
+    if (!field.address.empty())
+    {
+      auto& node = ossia::net::create_node(root, field.address);
+      param = node.create_parameter(valueType(field));
+      param->set_access(ossia::access_mode::GET);
+    }
+    m_parameters.push_back(param);
+  }
+
+  for (const auto& output : spec().outputs)
+  {
+    if (output.address.empty())
+      continue;
+
+    // A field which is read can also be written to
+    auto& node = ossia::net::find_or_create_node(root, output.address);
+    auto param = node.get_parameter();
+    if (param)
+    {
+      param->set_access(ossia::access_mode::BI);
+    }
+    else
+    {
+      param = node.create_parameter(valueType(output));
+      param->set_access(ossia::access_mode::SET);
+    }
+    m_outputs.emplace_back(param, &output);
+  }
+
+  QMetaObject::invokeMethod(this, [this] { start(); }, Qt::QueuedConnection);
+}
+
+void FramedProtocol::start()
+{
+  // The script is only evaluated again if it post-processes the frames
+  if (m_code.contains("onFrame"))
+  {
+    m_engine = new QQmlEngine{this};
+    auto component = new QQmlComponent{m_engine};
+    component->setData(m_code, QUrl{});
+    if (auto object = component->create())
+    {
+      object->setParent(m_engine);
+      m_onFrame = m_engine->newQObject(object).property("onFrame");
+    }
+
+    if (!m_onFrame.isCallable())
+    {
+      delete m_engine;
+      m_engine = nullptr;
+    }
+  }
+
+  open();
+}
+
+void FramedProtocol::feed(const char* data, std::size_t size)
+{
+  m_bytes += size;
+  const auto errors = m_decoder.errors();
+  m_decoder.feed(data, size, [this](const char* frame, std::size_t size) {
+    onFrame(frame, size);
+  });
+  m_errors += m_decoder.errors() - errors;
+}
+
+void FramedProtocol::onFrame(const char* data, std::size_t size)
+{
+  if (!m_decoder.decode(data, size, m_values))
+    return;
+  m_frames++;
+
+  const std::size_t n = std::min(m_values.size(), m_parameters.size());
+  for (std::size_t i = 0; i < n; i++)
+  {
+    if (auto p = m_parameters[i])
+      p->set_value(m_values[i]);
+  }
+
+  if (m_engine)
+  {
+    auto values = m_engine->newArray(m_values.size());
+    for (std::size_t i = 0; i < m_values.size(); i++)
+      values.setProperty(i, ossia::qt::value_to_js_value(m_values[i], *m_engine));
+
+    // Same replies as the other device scripts: [ { address, value }, ... ]
+    const auto res = m_onFrame.call({values});
+    QJSValueIterator it(res);
+    while (it.hasNext())
+    {
+      it.next();
+      const auto reply = it.value();
+      const auto addr = reply.property("address");
+      const auto v = reply.property("value");
+      if (!addr.isString() || v.isUndefined())
+        continue;
+
+      if (auto node = ossia::net::find_node(m_device->get_root_node(), addr.toString().toStdString()))
+        if (auto p = node->get_parameter())
+          p->set_value(ossia::qt::value_from_js(p->value(), v));
+    }
+  }
+}
+}
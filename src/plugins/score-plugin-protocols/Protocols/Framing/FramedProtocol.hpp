@@ -0,0 +1,111 @@
+#pragma once
+#include <Protocols/Framing/FrameDecoder.hpp>
+
+#include <ossia/network/base/protocol.hpp>
+
+#include <QByteArray>
+#include <QJSValue>
+#include <QObject>
+#include <QThread>
+
+#include <score_plugin_protocols_export.h>
+
+#include <atomic>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <verdigris>
+
+class QQmlEngine;
+namespace Protocols
+{
+/**
+ * @brief Reads the "framing" property of the root object of a device script.
+ *
+ * Returns nothing if the script does not declare one: the device is then
+ * handled entirely by the script, as before. The result is kept for the
+ * next calls with the same script, e.g. when the device reconnects.
+ */
+SCORE_PLUGIN_PROTOCOLS_EXPORT
+std::optional<FramingSpec> readFramingSpec(const QByteArray& code);
+
+/**
+ * @brief Base for the protocols which decode their input natively.
+ *
+ * The parameters are created from the fields of the framing spec; each
+ * decoded frame sets their values directly, without going through the
+ * QML engine. If the script defines an onFrame(values) function, it is
+ * called afterwards with the decoded values, and can return an array of
+ * { address, value } objects like the other device scripts.
+ *
+ * The outputs of the spec are parameters which can be written to: each
+ * value pushed to them is encoded in a frame, which is given to write()
+ * in the thread of the protocol.
+ *
+ * The transport lives in the thread of the protocol: implementations
+ * create it in open(), destroy it in close(), and pass what they receive
+ * to feed(). They must call stop() in their destructor.
+ */
+class SCORE_PLUGIN_PROTOCOLS_EXPORT FramedProtocol
+    : public QObject
+    , public ossia::net::protocol_base
+{
+  W_OBJECT(FramedProtocol)
+public:
+  struct Statistics
+  {
+    uint64_t bytes{};
+    uint64_t frames{};
+    uint64_t errors{};
+  };
+
+  FramedProtocol(FramingSpec spec, const QByteArray& code);
+  ~FramedProtocol() override;
+
+  Statistics statistics() const noexcept;
+
+  //! Closes the transport and stops the thread, e.g. when the device disconnects
+  void stop();
+
+protected:
+  virtual void open() = 0;
+  virtual void close() = 0;
+
+  //! Sends a complete frame; called from the thread of the protocol
+  virtual void write(const char* data, std::size_t size) = 0;
+
+  //! Called from the thread of the protocol
+  void feed(const char* data, std::size_t size);
+
+  const FramingSpec& spec() const noexcept { return m_decoder.spec(); }
+
+private:
+  bool pull(ossia::net::parameter_base& p) override;
+  bool push(const ossia::net::parameter_base& p, const ossia::value& v) override;
+  bool push_raw(const ossia::net::full_parameter_data& p) override;
+  bool observe(ossia::net::parameter_base& p, bool b) override;
+  bool update(ossia::net::node_base& n) override;
+  void set_device(ossia::net::device_base& dev) override;
+
+  void start();
+  void onFrame(const char* data, std::size_t size);
+
+  QByteArray m_code;
+  FrameDecoder m_decoder;
+  ossia::net::device_base* m_device{};
+  std::vector<ossia::net::parameter_base*> m_parameters;
+  std::vector<std::pair<const ossia::net::parameter_base*, const FrameField*>> m_outputs;
+  std::vector<ossia::value> m_values;
+
+  // Only created if the script post-processes the frames
+  QQmlEngine* m_engine{};
+  QJSValue m_onFrame;
+
+  std::atomic<uint64_t> m_bytes{};
+  std::atomic<uint64_t> m_frames{};
+  std::atomic<uint64_t> m_errors{};
+
+  QThread m_thread;
+};
+}
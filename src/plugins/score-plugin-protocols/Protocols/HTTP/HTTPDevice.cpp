@@ -5,17 +5,85 @@
 #include <Device/Protocol/DeviceSettings.hpp>
 #include <Explorer/DeviceList.hpp>
 #include <Explorer/DeviceLogging.hpp>
+#include <Protocols/AsyncOutputProtocol.hpp>
 #include <Protocols/HTTP/HTTPSpecificSettings.hpp>
 
 #include <ossia-qt/http/http_protocol.hpp>
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/generic/generic_parameter.hpp>
 
+#if __has_include(<QQmlEngine>)
+#include <Protocols/Framing/FramedProtocol.hpp>
+
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QTimer>
+#endif
+
 #include <wobjectimpl.h>
 
 #include <memory>
 namespace Protocols
 {
+#if __has_include(<QQmlEngine>)
+namespace
+{
+// Decodes the body of the replies as it arrives: the url can stream
+// continuously, or be requested again after the interval.
+// The frames written to the outputs are posted to the same url.
+class framed_http_protocol final : public FramedProtocol
+{
+public:
+  using FramedProtocol::FramedProtocol;
+  ~framed_http_protocol() override { stop(); }
+
+private:
+  void open() override
+  {
+    m_manager = new QNetworkAccessManager{this};
+    request();
+  }
+
+  void close() override
+  {
+    m_closing = true;
+    delete m_manager;
+    m_manager = nullptr;
+  }
+
+  void write(const char* data, std::size_t size) override
+  {
+    if (!m_manager)
+      return;
+
+    auto reply = m_manager->post(
+        QNetworkRequest{QUrl{QString::fromStdString(spec().url)}}, QByteArray{data, int(size)});
+    QObject::connect(reply, &QNetworkReply::finished, reply, &QObject::deleteLater);
+  }
+
+  void request()
+  {
+    if (m_closing)
+      return;
+
+    auto reply = m_manager->get(QNetworkRequest{QUrl{QString::fromStdString(spec().url)}});
+    QObject::connect(reply, &QNetworkReply::readyRead, this, [this, reply] {
+      const auto data = reply->readAll();
+      feed(data.constData(), data.size());
+    });
+    QObject::connect(reply, &QNetworkReply::finished, this, [this, reply] {
+      reply->deleteLater();
+      if (!m_closing)
+        QTimer::singleShot(spec().interval, this, [this] { request(); });
+    });
+  }
+
+  QNetworkAccessManager* m_manager{};
+  bool m_closing{};
+};
+}
+#endif
+
 HTTPDevice::HTTPDevice(const Device::DeviceSettings& settings) : OwningDeviceInterface{settings}
 {
   m_capas.canRefreshTree = true;
@@ -26,6 +94,12 @@ HTTPDevice::HTTPDevice(const Device::DeviceSettings& settings) : OwningDeviceInt
   m_capas.canSerialize = false;
 }
 
+HTTPDevice::~HTTPDevice()
+{
+  if (m_output)
+    m_output->stop();
+}
+
 bool HTTPDevice::reconnect()
 {
   disconnect();
@@ -33,10 +107,30 @@ bool HTTPDevice::reconnect()
   try
   {
     auto stgs = settings().deviceSpecificSettings.value<HTTPSpecificSettings>();
+    const auto code = stgs.text.toUtf8();
+
+#if __has_include(<QQmlEngine>)
+    // The replies are decoded natively if the script declares their layout
+    if (auto spec = readFramingSpec(code); spec && !spec->url.empty())
+    {
+      auto proto = std::make_unique<framed_http_protocol>(std::move(*spec), code);
+      auto framed = proto.get();
 
-    m_dev = std::make_unique<ossia::net::http_device>(
-        std::make_unique<ossia::net::http_protocol>(stgs.text.toUtf8()),
-        settings().name.toStdString());
+      m_dev = std::make_unique<ossia::net::generic_device>(
+          std::move(proto), settings().name.toStdString());
+      m_framed = framed;
+    }
+    else
+#endif
+    {
+      auto proto = std::make_unique<AsyncOutputProtocol>(
+          std::make_unique<ossia::net::http_protocol>(code));
+      auto output = proto.get();
+
+      m_dev = std::make_unique<ossia::net::http_device>(
+          std::move(proto), settings().name.toStdString());
+      m_output = output;
+    }
     deviceChanged(nullptr, m_dev.get());
 
     enableCallbacks();
@@ -53,4 +147,21 @@ bool HTTPDevice::reconnect()
 
   return connected();
 }
+
+void HTTPDevice::disconnect()
+{
+  // The values waiting to be sent refer to the parameters of the device
+  if (m_output)
+  {
+    m_output->stop();
+    m_output = nullptr;
+  }
+  // The reader thread sets the values of the parameters
+  if (m_framed)
+  {
+    m_framed->stop();
+    m_framed = nullptr;
+  }
+  OwningDeviceInterface::disconnect();
+}
 }
@@ -3,11 +3,19 @@
 
 namespace Protocols
 {
+class AsyncOutputProtocol;
+class FramedProtocol;
 class HTTPDevice final : public Device::OwningDeviceInterface
 {
 public:
   HTTPDevice(const Device::DeviceSettings& settings);
+  ~HTTPDevice() override;
 
   bool reconnect() override;
+  void disconnect() override;
+
+private:
+  AsyncOutputProtocol* m_output{};
+  FramedProtocol* m_framed{};
 };
 }
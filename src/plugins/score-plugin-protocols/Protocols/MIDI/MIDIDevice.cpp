@@ -70,10 +70,10 @@ void MIDIDevice::disconnect()
 {
   if (connected())
   {
-    removeListening_impl(m_dev->get_root_node(), State::Address{m_settings.name, {}});
+    removeListening_impl(State::Address{m_settings.name, {}});
   }
 
-  m_callbacks.clear();
+  m_listening.clear();
   auto old = m_dev.get();
   m_dev.reset();
   deviceChanged(old, nullptr);
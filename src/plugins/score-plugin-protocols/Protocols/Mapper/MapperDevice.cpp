@@ -30,10 +30,13 @@
 #include <QQmlEngine>
 #include <QThread>
 
+#include <spdlog/logger.h>
 #include <wobjectimpl.h>
 
+#include <chrono>
 #include <iomanip>
 #include <sstream>
+#include <utility>
 #include <verdigris>
 
 namespace ossia::net
@@ -201,13 +204,27 @@ struct mapper_parameter_data_base
   mapper_parameter_data_base& operator=(mapper_parameter_data_base&&) = default;
 
   mapper_parameter_data_base(const QJSValue& val)
-      : bind{val.property("bind")}, read{val.property("read")}, write{val.property("write")}
+      : bind{val.property("bind")}
+      , read{val.property("read")}
+      , readBatch{val.property("readBatch")}
+      , write{val.property("write")}
+      , bound{bind.isString() || bind.isArray()}
+      , readable{read.isCallable()}
+      , batchReadable{readBatch.isCallable()}
+      , writable{write.isCallable()}
   {
   }
 
   QJSValue bind;
   QJSValue read;
+  QJSValue readBatch;
   QJSValue write;
+
+  // Checked once instead of on every value
+  bool bound{};
+  bool readable{};
+  bool batchReadable{};
+  bool writable{};
   ossia::small_vector<ossia::net::parameter_base*, 4> source{};
   std::unique_ptr<std::mutex> source_lock{std::make_unique<std::mutex>()};
 };
@@ -253,7 +270,10 @@ public:
   {
     std::lock_guard g{*data().source_lock};
     if (auto p = s.get_parameter())
+    {
       ossia::remove_erase(data().source, p);
+      source_addresses.erase(p);
+    }
 
     callbacks.erase(&s);
   }
@@ -269,6 +289,9 @@ public:
   std::atomic_bool m_stop_callbacks = false;
   ossia::fast_hash_map<const ossia::net::node_base*, ossia::net::parameter_base::iterator>
       callbacks;
+
+  // Passed to the read handlers
+  ossia::fast_hash_map<const ossia::net::parameter_base*, QString> source_addresses;
 };
 using mapper_node = ossia::net::wrapped_node<mapper_parameter_data, mapper_parameter>;
 
@@ -276,14 +299,40 @@ class mapper_protocol final : public QObject, public ossia::net::protocol_base
 {
   W_OBJECT(mapper_protocol)
 public:
+  struct recv_update
+  {
+    mapper_parameter* param{};
+    ossia::net::parameter_base* source{};
+    ossia::value value;
+  };
+  struct push_update
+  {
+    mapper_parameter* param{};
+    ossia::value value;
+  };
+  struct recv_key_hash
+  {
+    std::size_t
+    operator()(const std::pair<mapper_parameter*, ossia::net::parameter_base*>& k) const noexcept
+    {
+      return std::hash<void*>{}(k.first) ^ (std::hash<void*>{}(k.second) << 1);
+    }
+  };
+
   mapper_protocol(const QByteArray& code, Device::DeviceList& roots)
       : m_code{code}, m_devices{roots}, m_roots{m_devices.roots()}
   {
     m_engine = new QQmlEngine{this};
     m_component = new QQmlComponent{m_engine};
 
-    connect(this, &mapper_protocol::sig_push, this, &mapper_protocol::slot_push);
-    connect(this, &mapper_protocol::sig_recv, this, &mapper_protocol::slot_recv);
+    // Queued even from the mapper thread: values pushed by the handlers
+    // go in the next batch
+    connect(
+        this,
+        &mapper_protocol::sig_batch,
+        this,
+        &mapper_protocol::process_batch,
+        Qt::QueuedConnection);
     con(m_devices,
         &observable_device_roots::rootsChanged,
         this,
@@ -331,9 +380,146 @@ public:
     m_thread.wait();
   }
 
-  void sig_push(mapper_parameter* p, const ossia::value& v) W_SIGNAL(sig_push, p, v);
-  void sig_recv(mapper_parameter* p, ossia::net::parameter_base* s, const ossia::value& v)
-      W_SIGNAL(sig_recv, p, s, v);
+  struct statistics
+  {
+    uint64_t received{};
+    uint64_t pushed{};
+    uint64_t coalesced{};
+    uint64_t batches{};
+    uint64_t calls{};
+    std::chrono::microseconds scriptTime{};
+  };
+
+  statistics get_statistics() const noexcept
+  {
+    return {
+        m_received,
+        m_pushed,
+        m_coalesced,
+        m_batches,
+        m_calls,
+        std::chrono::microseconds{m_scriptTime.load()}};
+  }
+
+  void sig_batch() W_SIGNAL(sig_batch);
+
+  //! Can be called from any thread: the value is handled in the next batch.
+  //! The read and write handlers get every value; only the readBatch
+  //! handlers get the last value of each of their sources.
+  void enqueue_recv(mapper_parameter* p, ossia::net::parameter_base* s, const ossia::value& v)
+  {
+    m_received++;
+    bool schedule{};
+    {
+      std::lock_guard l{m_batchLock};
+      if (p->data().batchReadable)
+      {
+        auto [it, inserted] = m_recvIndex.try_emplace({p, s}, m_recvBatch.size());
+        if (inserted)
+        {
+          m_recvBatch.push_back({p, s, v});
+        }
+        else
+        {
+          m_recvBatch[it->second].value = v;
+          m_coalesced++;
+        }
+      }
+      else
+      {
+        m_recvBatch.push_back({p, s, v});
+      }
+      schedule = !std::exchange(m_batchScheduled, true);
+    }
+
+    if (schedule)
+      sig_batch();
+  }
+
+  void enqueue_push(mapper_parameter* p, const ossia::value& v)
+  {
+    m_pushed++;
+    bool schedule{};
+    {
+      std::lock_guard l{m_batchLock};
+      m_pushBatch.push_back({p, v});
+      schedule = !std::exchange(m_batchScheduled, true);
+    }
+
+    if (schedule)
+      sig_batch();
+  }
+
+  void process_batch()
+  {
+    std::shared_ptr<spdlog::logger> logger;
+    {
+      std::lock_guard l{m_batchLock};
+      std::swap(m_recvBatch, m_recvProcessing);
+      std::swap(m_pushBatch, m_pushProcessing);
+      m_recvIndex.clear();
+      m_batchScheduled = false;
+      logger = m_logger;
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // Parameters with a readBatch handler get the values of all their sources at once
+    for (const auto& u : m_recvProcessing)
+    {
+      if (u.param->data().batchReadable)
+        m_batchReads[u.param].push_back(&u);
+      else
+        slot_recv(u.param, u.source, u.value);
+    }
+    for (const auto& [param, updates] : m_batchReads)
+      slot_recv_batch(param, updates);
+
+    for (const auto& u : m_pushProcessing)
+      slot_push(u.param, u.value);
+
+    m_batchReads.clear();
+    m_recvProcessing.clear();
+    m_pushProcessing.clear();
+
+    const auto t1 = std::chrono::steady_clock::now();
+    m_batches++;
+    m_scriptTime += std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+
+    if (logger)
+      log_statistics(*logger, t1);
+  }
+
+  //! Writes the throughput since the last time, at most once per second
+  void log_statistics(spdlog::logger& logger, std::chrono::steady_clock::time_point now)
+  {
+    if (m_lastLogTime == std::chrono::steady_clock::time_point{})
+    {
+      m_lastLogStatistics = get_statistics();
+      m_lastLogTime = now;
+      return;
+    }
+
+    const std::chrono::duration<double> elapsed = now - m_lastLogTime;
+    if (elapsed.count() < 1.)
+      return;
+
+    const auto cur = get_statistics();
+    const auto& prev = m_lastLogStatistics;
+    const double secs = elapsed.count();
+    logger.info(
+        "Mapper: {:.1f} received/s, {:.1f} pushed/s, {:.1f} coalesced/s, {:.1f} "
+        "batches/s, {:.1f} calls/s, {:.1f} ms/s in scripts",
+        (cur.received - prev.received) / secs,
+        (cur.pushed - prev.pushed) / secs,
+        (cur.coalesced - prev.coalesced) / secs,
+        (cur.batches - prev.batches) / secs,
+        (cur.calls - prev.calls) / secs,
+        (cur.scriptTime - prev.scriptTime).count() / (1000. * secs));
+
+    m_lastLogStatistics = cur;
+    m_lastLogTime = now;
+  }
 
   void slot_push(mapper_parameter* param, const ossia::value& v)
   {
@@ -341,8 +527,8 @@ public:
     auto& dat = addr.data();
     auto cb = param->stop_callbacks();
 
-    bool write = dat.write.isCallable();
-    bool bound = dat.bind.isString() || dat.bind.isArray();
+    const bool write = dat.writable;
+    const bool bound = dat.bound;
     if (!write && bound)
     {
       std::lock_guard g{*dat.source_lock};
@@ -356,6 +542,7 @@ public:
     }
     else if (write)
     {
+      m_calls++;
       auto res = dat.write.call({qt::value_to_js_value(v, *m_engine)});
       if (bound)
       {
@@ -399,19 +586,45 @@ public:
 
   void slot_recv(mapper_parameter* p, ossia::net::parameter_base* s, const ossia::value& v)
   {
-    if (!p->data().read.isCallable())
+    if (!p->data().readable)
     {
       p->set_value(v);
     }
     else
     {
+      m_calls++;
       auto res = p->data().read.call(
-          {QString::fromStdString(s->get_node().osc_address()),
-           qt::value_to_js_value(v, *m_engine)});
+          {source_address(*p, *s), qt::value_to_js_value(v, *m_engine)});
       p->set_value(qt::value_from_js(std::move(res)));
     }
   }
 
+  void slot_recv_batch(mapper_parameter* p, const std::vector<const recv_update*>& updates)
+  {
+    // [ { address, value }, ... ]
+    auto arr = m_engine->newArray(updates.size());
+    for (std::size_t i = 0; i < updates.size(); i++)
+    {
+      auto obj = m_engine->newObject();
+      obj.setProperty("address", source_address(*p, *updates[i]->source));
+      obj.setProperty("value", qt::value_to_js_value(updates[i]->value, *m_engine));
+      arr.setProperty(i, obj);
+    }
+
+    m_calls++;
+    auto res = p->data().readBatch.call({arr});
+    p->set_value(qt::value_from_js(std::move(res)));
+  }
+
+  static QString source_address(mapper_parameter& p, const ossia::net::parameter_base& s)
+  {
+    std::lock_guard g{*p.data().source_lock};
+    auto it = p.source_addresses.find(&s);
+    if (it != p.source_addresses.end())
+      return it->second;
+    return QString::fromStdString(s.get_node().osc_address());
+  }
+
   static mapper_parameter_data read_data(const QJSValue& js) { return js; }
 
 private:
@@ -447,7 +660,7 @@ private:
 
   bool push(const ossia::net::parameter_base& parameter_base, const ossia::value& v) override
   {
-    sig_push((mapper_parameter*)&parameter_base, v);
+    enqueue_push((mapper_parameter*)&parameter_base, v);
     return true;
   }
 
@@ -457,6 +670,13 @@ private:
 
   bool update(ossia::net::node_base& node_base) override { return true; }
 
+  void set_logger(const ossia::net::network_logger& l) override
+  {
+    // The throughput is logged with the outbound messages
+    std::lock_guard lck{m_batchLock};
+    m_logger = l.outbound_logger;
+  }
+
   void set_device(device_base& dev) override
   {
     m_device = &dev;
@@ -476,6 +696,33 @@ private:
 
   std::mutex m_rootLock;
   std::vector<ossia::net::node_base*> m_roots;
+
+  // Values waiting for the next batch, in the order they were received.
+  // The index only refers to the values for readBatch handlers.
+  std::mutex m_batchLock;
+  std::vector<recv_update> m_recvBatch;
+  std::vector<push_update> m_pushBatch;
+  ossia::fast_hash_map<
+      std::pair<mapper_parameter*, ossia::net::parameter_base*>,
+      std::size_t,
+      recv_key_hash>
+      m_recvIndex;
+  bool m_batchScheduled{};
+  std::shared_ptr<spdlog::logger> m_logger;
+
+  // Only accessed from the mapper thread
+  std::vector<recv_update> m_recvProcessing;
+  std::vector<push_update> m_pushProcessing;
+  ossia::fast_hash_map<mapper_parameter*, std::vector<const recv_update*>> m_batchReads;
+  statistics m_lastLogStatistics;
+  std::chrono::steady_clock::time_point m_lastLogTime;
+
+  std::atomic<uint64_t> m_received{};
+  std::atomic<uint64_t> m_pushed{};
+  std::atomic<uint64_t> m_coalesced{};
+  std::atomic<uint64_t> m_batches{};
+  std::atomic<uint64_t> m_calls{};
+  std::atomic<int64_t> m_scriptTime{};
 };
 
 using mapper_device = ossia::net::wrapped_device<mapper_node, mapper_protocol>;
@@ -484,10 +731,12 @@ void mapper_parameter::connect(parameter_base& s, mapper_protocol& proto)
 {
   set_value(s.value());
   s.get_node().about_to_be_deleted.connect<&mapper_parameter::on_sourceRemoved>(*this);
+  // The source lock is held by the caller
+  source_addresses[&s] = QString::fromStdString(s.get_node().osc_address());
   // TODO handle parameter removal from device -> some hash_map
   callbacks[&s.get_node()] = s.add_callback([this, param = &s, &proto](const ossia::value& v) {
     if (!this->m_stop_callbacks)
-      proto.sig_recv(this, param, v);
+      proto.enqueue_recv(this, param, v);
   });
 }
 
@@ -5,10 +5,14 @@
 #include <Device/Protocol/DeviceSettings.hpp>
 #include <Explorer/DeviceList.hpp>
 #include <Explorer/DeviceLogging.hpp>
+#include <Protocols/OSC/OSCSendScheduler.hpp>
 #include <Protocols/OSC/OSCSpecificSettings.hpp>
 
 #include <score/application/ApplicationContext.hpp>
 
+#include <ossia/network/base/parameter_data.hpp>
+#include <ossia/network/base/protocol.hpp>
+#include <ossia/network/domain/domain.hpp>
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/generic/generic_parameter.hpp>
 #include <ossia/network/osc/osc.hpp>
@@ -18,6 +22,83 @@
 
 namespace Protocols
 {
+namespace
+{
+// Receives through the OSC protocol, but sends through a scheduler
+// which groups the messages in bundles.
+class osc_bundling_protocol final : public ossia::net::protocol_base
+{
+public:
+  osc_bundling_protocol(
+      std::unique_ptr<ossia::net::protocol_base> osc,
+      const OSCSpecificSettings& stgs)
+      : m_protocol{std::move(osc)}
+      , m_scheduler{
+            stgs.host,
+            stgs.inputPort,
+            stgs.rate ? std::chrono::milliseconds{*stgs.rate} : std::chrono::milliseconds{1}}
+  {
+    m_scheduler.start();
+  }
+
+  // The values which are still pending are sent
+  ~osc_bundling_protocol() override { m_scheduler.stop(); }
+
+private:
+  bool pull(ossia::net::parameter_base& p) override { return m_protocol->pull(p); }
+
+  // Values are filtered like in ossia::net::osc_protocol before being queued
+  template <typename Parameter>
+  static ossia::value filter(const Parameter& p, const ossia::value& v)
+  {
+    if (p.get_access() == ossia::access_mode::GET)
+      return {};
+    return ossia::apply_domain(p.get_domain(), p.get_bounding(), v);
+  }
+
+  bool push(const ossia::net::parameter_base& p, const ossia::value& v) override
+  {
+    if (p.filter_value(v))
+      return false;
+
+    auto val = filter(p, v);
+    if (!val.valid())
+      return false;
+
+    m_scheduler.push(p.get_node().osc_address(), std::move(val));
+    return true;
+  }
+
+  bool push_raw(const ossia::net::full_parameter_data& p) override
+  {
+    auto val = filter(p, p.value());
+    if (!val.valid())
+      return false;
+
+    m_scheduler.push(p.address, std::move(val));
+    return true;
+  }
+
+  bool observe(ossia::net::parameter_base& p, bool b) override
+  {
+    return m_protocol->observe(p, b);
+  }
+
+  bool update(ossia::net::node_base& n) override { return m_protocol->update(n); }
+
+  void set_device(ossia::net::device_base& dev) override { m_protocol->set_device(dev); }
+
+  void set_logger(const ossia::net::network_logger& l) override
+  {
+    // The scheduler logs its rates in the outbound messages
+    m_scheduler.setLogger(l.outbound_logger);
+    m_protocol->set_logger(l);
+  }
+
+  std::unique_ptr<ossia::net::protocol_base> m_protocol;
+  OSCSendScheduler m_scheduler;
+};
+}
 
 OSCDevice::OSCDevice(const Device::DeviceSettings& settings) : OwningDeviceInterface{settings}
 {
@@ -33,10 +114,16 @@ bool OSCDevice::reconnect()
   try
   {
     const OSCSpecificSettings& stgs = settings().deviceSpecificSettings.value<OSCSpecificSettings>();
-    std::unique_ptr<ossia::net::protocol_base> ossia_settings
-        = std::make_unique<ossia::net::osc_protocol>(
-            stgs.host.toStdString(), stgs.inputPort, stgs.outputPort);
-    if (stgs.rate)
+    auto osc = std::make_unique<ossia::net::osc_protocol>(
+        stgs.host.toStdString(), stgs.inputPort, stgs.outputPort);
+    m_osc = osc.get();
+
+    std::unique_ptr<ossia::net::protocol_base> ossia_settings = std::move(osc);
+    if (stgs.bundle)
+    {
+      ossia_settings = std::make_unique<osc_bundling_protocol>(std::move(ossia_settings), stgs);
+    }
+    else if (stgs.rate)
     {
       ossia_settings = std::make_unique<ossia::net::rate_limiting_protocol>(
           std::chrono::milliseconds{*stgs.rate}, std::move(ossia_settings));
@@ -65,15 +152,15 @@ void OSCDevice::recreate(const Device::Node& n)
 
 bool OSCDevice::isLearning() const
 {
-  auto& proto = static_cast<ossia::net::osc_protocol&>(m_dev->get_protocol());
-  return proto.learning();
+  // The OSC protocol may be wrapped
+  return m_osc->learning();
 }
 
 void OSCDevice::setLearning(bool b)
 {
   if (!m_dev)
     return;
-  auto& proto = static_cast<ossia::net::osc_protocol&>(m_dev->get_protocol());
+  auto& proto = *m_osc;
   auto& dev = *m_dev;
   if (b)
   {
@@ -1,6 +1,11 @@
 #pragma once
 #include <Device/Protocol/DeviceInterface.hpp>
 
+namespace ossia::net
+{
+class osc_protocol;
+}
+
 namespace Protocols
 {
 class OSCDevice final : public Device::OwningDeviceInterface
@@ -13,5 +18,8 @@ public:
 
   bool isLearning() const final override;
   void setLearning(bool) final override;
+
+private:
+  ossia::net::osc_protocol* m_osc{};
 };
 }
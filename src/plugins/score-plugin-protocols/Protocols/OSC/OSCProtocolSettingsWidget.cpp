@@ -13,6 +13,7 @@
 
 #include <score/widgets/MarginLess.hpp>
 
+#include <QCheckBox>
 #include <QFormLayout>
 #include <QLineEdit>
 #include <QSpinBox>
@@ -38,12 +39,16 @@ OSCProtocolSettingsWidget::OSCProtocolSettingsWidget(QWidget* parent)
 
   m_rate = new RateWidget{this};
 
+  m_bundle = new QCheckBox{this};
+  m_bundle->setToolTip(tr("Send the messages of each tick grouped in OSC bundles"));
+
   auto layout = new QFormLayout{this};
   layout->addRow(tr("Name"), m_deviceNameEdit);
   layout->addRow(tr("Device listening port"), m_portInputSBox);
   layout->addRow(tr("score listening port"), m_portOutputSBox);
   layout->addRow(tr("Host"), m_localHostEdit);
   layout->addRow(tr("Rate"), m_rate);
+  layout->addRow(tr("Bundles"), m_bundle);
   setDefaults();
 }
 
@@ -54,6 +59,7 @@ void OSCProtocolSettingsWidget::setDefaults()
   m_portInputSBox->setValue(9996);
   m_localHostEdit->setText("127.0.0.1");
   m_rate->setRate({});
+  m_bundle->setChecked(false);
 }
 
 Device::DeviceSettings OSCProtocolSettingsWidget::getSettings() const
@@ -67,6 +73,7 @@ Device::DeviceSettings OSCProtocolSettingsWidget::getSettings() const
   osc.inputPort = m_portInputSBox->value();
   osc.outputPort = m_portOutputSBox->value();
   osc.rate = m_rate->rate();
+  osc.bundle = m_bundle->isChecked();
   osc.jsonToLoad.clear();
 
   // TODO list.append(m_namespaceFilePathEdit->text());
@@ -101,6 +108,7 @@ void OSCProtocolSettingsWidget::setSettings(const Device::DeviceSettings& settin
     m_portOutputSBox->setValue(m_settings.outputPort);
     m_localHostEdit->setText(m_settings.host);
     m_rate->setRate(m_settings.rate);
+    m_bundle->setChecked(m_settings.bundle);
   }
 }
 }
@@ -4,6 +4,7 @@
 #include <Protocols/OSC/OSCSpecificSettings.hpp>
 #include <verdigris>
 
+class QCheckBox;
 class QLineEdit;
 class QSpinBox;
 class QWidget;
@@ -27,6 +28,7 @@ private:
   QSpinBox* m_portInputSBox{};
   QLineEdit* m_localHostEdit{};
   RateWidget* m_rate{};
+  QCheckBox* m_bundle{};
   OSCSpecificSettings m_settings;
 };
 }
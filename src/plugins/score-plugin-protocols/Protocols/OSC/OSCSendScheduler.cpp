@@ -0,0 +1,241 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "OSCSendScheduler.hpp"
+
+#include <ossia/network/osc/detail/osc.hpp>
+
+#include <QHostInfo>
+#include <QUdpSocket>
+
+#include <oscpack/osc/OscOutboundPacketStream.h>
+#include <spdlog/logger.h>
+
+namespace Protocols
+{
+namespace
+{
+void writeInt(QByteArray& b, uint32_t v)
+{
+  const char bytes[4]{char(v >> 24), char(v >> 16), char(v >> 8), char(v)};
+  b.append(bytes, 4);
+}
+
+//! Encodes a message with the same writer as ossia's OSC protocol
+bool writeMessage(
+    oscpack::OutboundPacketStream& p,
+    const std::string& address,
+    const ossia::value& v)
+{
+  try
+  {
+    p.Clear();
+    p << oscpack::BeginMessage(address.c_str());
+    v.apply(ossia::net::osc_outbound_visitor{p});
+    p << oscpack::EndMessage;
+    return true;
+  }
+  catch (...)
+  {
+    // Does not fit in a datagram
+    return false;
+  }
+}
+
+QByteArray makeBundleHeader(std::chrono::system_clock::time_point t)
+{
+  // NTP time: seconds since 1900 and fraction of second
+  using namespace std::chrono;
+  const auto since_epoch = duration_cast<nanoseconds>(t.time_since_epoch());
+  const auto secs = duration_cast<seconds>(since_epoch);
+  const uint64_t frac = ((since_epoch - secs).count() * (uint64_t(1) << 32)) / 1'000'000'000;
+
+  QByteArray b;
+  b.append("#bundle", 8);
+  writeInt(b, uint32_t(secs.count() + 2208988800ULL));
+  writeInt(b, uint32_t(frac));
+  return b;
+}
+}
+
+OSCSendScheduler::OSCSendScheduler(
+    const QString& host,
+    int port,
+    std::chrono::microseconds period,
+    int maxSize)
+    : m_host{host}, m_port{port}, m_period{period}, m_maxSize{maxSize}
+{
+}
+
+OSCSendScheduler::~OSCSendScheduler()
+{
+  stop();
+}
+
+void OSCSendScheduler::start()
+{
+  if (m_running)
+    return;
+
+  m_running = true;
+  m_thread = std::thread{[this] { run(); }};
+}
+
+void OSCSendScheduler::stop()
+{
+  {
+    std::lock_guard lck{m_mutex};
+    m_running = false;
+  }
+  m_cv.notify_one();
+
+  // The thread sends the pending values before exiting
+  if (m_thread.joinable())
+    m_thread.join();
+  else
+    flush();
+}
+
+void OSCSendScheduler::push(std::string address, const ossia::value& v)
+{
+  bool first = false;
+  {
+    std::lock_guard lck{m_mutex};
+    auto [it, inserted] = m_index.try_emplace(std::move(address), m_pending.size());
+    if (inserted)
+    {
+      first = m_pending.empty();
+      if (first)
+        m_batchTime = std::chrono::system_clock::now();
+      m_pending.emplace_back(it->first, v);
+    }
+    else
+    {
+      m_pending[it->second].second = v;
+    }
+  }
+
+  if (first)
+    m_cv.notify_one();
+}
+
+void OSCSendScheduler::run()
+{
+  std::unique_lock lck{m_mutex};
+  while (m_running)
+  {
+    m_cv.wait(lck, [this] { return !m_running || !m_pending.empty(); });
+    if (!m_running)
+      break;
+
+    // Let the rest of the tick come in, unless stopping
+    m_cv.wait_for(lck, m_period, [this] { return !m_running; });
+    lck.unlock();
+    flush();
+    lck.lock();
+  }
+  lck.unlock();
+
+  // The values pushed before stopping are still sent
+  flush();
+  m_socket.reset();
+}
+
+void OSCSendScheduler::flush()
+{
+  std::vector<std::pair<std::string, ossia::value>> pending;
+  std::chrono::system_clock::time_point time;
+  std::shared_ptr<spdlog::logger> logger;
+  {
+    std::lock_guard lck{m_mutex};
+    pending.swap(m_pending);
+    m_index.clear();
+    time = m_batchTime;
+    logger = m_logger;
+  }
+
+  if (pending.empty())
+    return;
+
+  if (!m_socket)
+  {
+    m_socket = std::make_unique<QUdpSocket>();
+    m_address = QHostAddress{m_host};
+    if (m_address.isNull())
+    {
+      const auto addresses = QHostInfo::fromName(m_host).addresses();
+      if (!addresses.isEmpty())
+        m_address = addresses.front();
+    }
+    m_windowStart = std::chrono::steady_clock::now();
+  }
+
+  if (m_address.isNull())
+    return;
+
+  // Largest UDP payload
+  static thread_local char buffer[65507];
+  oscpack::OutboundPacketStream p{buffer, sizeof(buffer)};
+
+  const QByteArray header = makeBundleHeader(time);
+  QByteArray bundle = header;
+  bundle.reserve(m_maxSize);
+
+  for (const auto& [address, value] : pending)
+  {
+    if (!writeMessage(p, address, value))
+      continue;
+
+    // A message larger than the limit still goes alone in its bundle
+    const int size = p.Size();
+    if (bundle.size() > header.size() && bundle.size() + 4 + size > m_maxSize)
+    {
+      send(bundle);
+      bundle = header;
+    }
+
+    writeInt(bundle, size);
+    bundle.append(p.Data(), size);
+  }
+
+  if (bundle.size() > header.size())
+    send(bundle);
+
+  const auto now = std::chrono::steady_clock::now();
+  const std::chrono::duration<double> elapsed = now - m_windowStart;
+  if (elapsed.count() >= 1.)
+  {
+    m_packetsPerSecond = m_windowPackets / elapsed.count();
+    m_bytesPerSecond = m_windowBytes / elapsed.count();
+    m_windowPackets = 0;
+    m_windowBytes = 0;
+    m_windowStart = now;
+
+    if (logger)
+      logger->info(
+          "OSC bundles: {:.1f} packets/s, {:.1f} bytes/s",
+          m_packetsPerSecond.load(),
+          m_bytesPerSecond.load());
+  }
+}
+
+void OSCSendScheduler::send(const QByteArray& bundle)
+{
+  m_socket->writeDatagram(bundle, m_address, m_port);
+
+  m_windowPackets++;
+  m_windowBytes += bundle.size();
+  m_packets++;
+  m_bytes += bundle.size();
+}
+
+OSCSendScheduler::Statistics OSCSendScheduler::statistics() const noexcept
+{
+  return {m_packets, m_bytes, m_packetsPerSecond, m_bytesPerSecond};
+}
+
+void OSCSendScheduler::setLogger(std::shared_ptr<spdlog::logger> logger)
+{
+  std::lock_guard lck{m_mutex};
+  m_logger = std::move(logger);
+}
+}
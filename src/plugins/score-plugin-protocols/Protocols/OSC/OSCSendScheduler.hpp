@@ -0,0 +1,115 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/network/value/value.hpp>
+
+#include <QHostAddress>
+#include <QString>
+
+#include <score_plugin_protocols_export.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class QUdpSocket;
+namespace spdlog
+{
+class logger;
+}
+namespace Protocols
+{
+/**
+ * @brief Groups the OSC messages sent to a device into bundles.
+ *
+ * Values can be pushed from any thread; only the last value of each
+ * address is kept until the next flush. The first value pushed after a
+ * flush opens a batch, which is sent after the configured period: this
+ * collects all the messages committed during an execution tick.
+ *
+ * The messages are packed into as few bundles as possible, each fitting
+ * in a datagram of at most the given size. All the bundles of a batch
+ * carry the time tag of the moment the batch was opened.
+ *
+ * The packets and bytes sent are counted, in total and per second; the
+ * rates are written to the logger if there is one.
+ */
+class SCORE_PLUGIN_PROTOCOLS_EXPORT OSCSendScheduler
+{
+public:
+  //! Largest UDP payload which is not fragmented on Ethernet
+  static constexpr int default_max_size = 1472;
+
+  struct Statistics
+  {
+    uint64_t packets{};
+    uint64_t bytes{};
+    double packetsPerSecond{};
+    double bytesPerSecond{};
+  };
+
+  OSCSendScheduler(
+      const QString& host,
+      int port,
+      std::chrono::microseconds period,
+      int maxSize = default_max_size);
+  ~OSCSendScheduler();
+
+  OSCSendScheduler(const OSCSendScheduler&) = delete;
+  OSCSendScheduler& operator=(const OSCSendScheduler&) = delete;
+
+  //! Starts the thread which flushes the batches
+  void start();
+  //! Sends the pending messages, then stops the thread
+  void stop();
+
+  //! Can be called from any thread. The value must already be filtered
+  //! as the OSC protocol would do, e.g. clipped to its domain.
+  void push(std::string address, const ossia::value& v);
+
+  //! Sends the pending messages right away. Only for a scheduler which
+  //! is not started, else the thread takes care of it.
+  void flush();
+
+  //! Can be called from any thread
+  Statistics statistics() const noexcept;
+
+  //! Logs the rates every second. Can be called from any thread.
+  void setLogger(std::shared_ptr<spdlog::logger> logger);
+
+private:
+  void run();
+  void send(const QByteArray& bundle);
+
+  QString m_host;
+  int m_port{};
+  std::chrono::microseconds m_period;
+  int m_maxSize{};
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  ossia::fast_hash_map<std::string, std::size_t> m_index;
+  std::vector<std::pair<std::string, ossia::value>> m_pending;
+  std::chrono::system_clock::time_point m_batchTime;
+  std::shared_ptr<spdlog::logger> m_logger;
+
+  // Only accessed by the flushing thread
+  std::unique_ptr<QUdpSocket> m_socket;
+  QHostAddress m_address;
+  std::chrono::steady_clock::time_point m_windowStart;
+  uint64_t m_windowPackets{};
+  uint64_t m_windowBytes{};
+
+  std::atomic<uint64_t> m_packets{};
+  std::atomic<uint64_t> m_bytes{};
+  std::atomic<double> m_packetsPerSecond{};
+  std::atomic<double> m_bytesPerSecond{};
+
+  std::thread m_thread;
+  std::atomic_bool m_running{};
+};
+}
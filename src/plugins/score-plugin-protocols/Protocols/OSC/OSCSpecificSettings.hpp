@@ -14,6 +14,9 @@ struct OSCSpecificSettings
   QString host;
   std::optional<int> rate{};
 
+  //! Send the messages of a tick in bundles instead of one datagram each
+  bool bundle{};
+
   // Note: this one is not saved, it is only used
   // to allow loading a .json file as an OSC device
   QByteArray jsonToLoad;
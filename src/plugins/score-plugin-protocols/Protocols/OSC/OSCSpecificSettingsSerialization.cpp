@@ -5,12 +5,18 @@
 #include <score/serialization/DataStreamVisitor.hpp>
 #include <score/serialization/JSONVisitor.hpp>
 
+// The settings used to end with jsonToLoad. The settings which
+// came after are preceded by a marker which cannot be mistaken for
+// the delimiter.
+static constexpr int32_t osc_bundle_marker = 1;
+
 template <>
 void DataStreamReader::read(const Protocols::OSCSpecificSettings& n)
 {
   // TODO put it in the right order before 1.0 final.
   // TODO same for minuit, etc..
   m_stream << n.outputPort << n.inputPort << n.host << n.rate << n.jsonToLoad;
+  m_stream << osc_bundle_marker << n.bundle;
   insertDelimiter();
 }
 
@@ -18,6 +24,18 @@ template <>
 void DataStreamWriter::write(Protocols::OSCSpecificSettings& n)
 {
   m_stream >> n.outputPort >> n.inputPort >> n.host >> n.rate >> n.jsonToLoad;
+
+  int32_t marker{};
+  m_stream >> marker;
+  if (marker != osc_bundle_marker)
+  {
+    // Older layout: the delimiter was just read
+    SCORE_ASSERT(marker == int32_t(0xDEADBEEF));
+    n.bundle = false;
+    return;
+  }
+
+  m_stream >> n.bundle;
   checkDelimiter();
 }
 
@@ -29,6 +47,8 @@ void JSONReader::read(const Protocols::OSCSpecificSettings& n)
   obj["Host"] = n.host;
   if (n.rate)
     obj["Rate"] = *n.rate;
+  if (n.bundle)
+    obj["Bundle"] = n.bundle;
 }
 
 template <>
@@ -39,4 +59,6 @@ void JSONWriter::write(Protocols::OSCSpecificSettings& n)
   n.host = obj["Host"].toString();
   if (auto it = obj.tryGet("Rate"))
     n.rate = it->toInt();
+  if (auto it = obj.tryGet("Bundle"))
+    n.bundle = it->toBool();
 }
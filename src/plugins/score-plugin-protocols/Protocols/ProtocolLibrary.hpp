@@ -14,7 +14,11 @@
 
 #include <ossia-qt/js_utilities.hpp>
 
+#include <QEventLoop>
 #include <QFileInfo>
+
+#include <future>
+#include <optional>
 #if __has_include(<QQmlEngine>)
 #include <QQmlComponent>
 #include <QQmlEngine>
@@ -57,11 +61,28 @@ class OSCLibraryHandler final : public Library::LibraryInterface
 
   bool onDoubleClick(const QString& path, const score::DocumentContext& ctx) override
   {
-    Device::Node n{Device::DeviceSettings{}, nullptr};
-    bool ok = (path.endsWith(".json") && Device::loadDeviceFromScoreJSON(path, n))
-              || (path.endsWith(".xml") && Device::loadDeviceFromXML(path, n))
-              || (path.endsWith(".device") && Device::loadDeviceFromJamomaJSON(path, n));
-    if (!ok)
+    // Large namespaces are parsed on a worker thread so that the GUI keeps
+    // being refreshed. The file is loaded before the device settings are
+    // asked, so that a file which cannot be read is not reported afterwards.
+    QEventLoop e;
+    auto loaded = std::async(std::launch::async, [path, &e]() -> std::optional<Device::Node> {
+      std::optional<Device::Node> res;
+      try
+      {
+        Device::Node n{Device::DeviceSettings{}, nullptr};
+        if (Device::loadDeviceFromFile(path, n))
+          res = std::move(n);
+      }
+      catch (...)
+      {
+      }
+      QMetaObject::invokeMethod(&e, &QEventLoop::quit, Qt::QueuedConnection);
+      return res;
+    });
+    e.exec(QEventLoop::ExcludeUserInputEvents);
+
+    auto node = loaded.get();
+    if (!node)
       return false;
 
     Device::ProtocolFactoryList fact;
@@ -95,6 +116,8 @@ class OSCLibraryHandler final : public Library::LibraryInterface
         }
       }
       ossia::net::sanitize_device_name(deviceSettings.name);
+
+      auto& n = *node;
       n.get<Device::DeviceSettings>() = deviceSettings;
 
       CommandDispatcher<>{ctx.commandStack}.submit(
@@ -7,16 +7,75 @@
 #include <Device/Protocol/DeviceSettings.hpp>
 #include <Explorer/DeviceList.hpp>
 #include <Explorer/DeviceLogging.hpp>
+#include <Protocols/AsyncOutputProtocol.hpp>
 #include <Protocols/Serial/SerialSpecificSettings.hpp>
 
 #include <ossia-qt/serial/serial_protocol.hpp>
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/generic/generic_parameter.hpp>
 
+#if __has_include(<QQmlEngine>)
+#include <Protocols/Framing/FramedProtocol.hpp>
+
+#include <QSerialPort>
+#endif
+
 #include <memory>
 
 namespace Protocols
 {
+#if __has_include(<QQmlEngine>)
+namespace
+{
+class framed_serial_protocol final : public FramedProtocol
+{
+public:
+  framed_serial_protocol(FramingSpec spec, const QByteArray& code, const QSerialPortInfo& port)
+      : FramedProtocol{std::move(spec), code}, m_info{port}
+  {
+  }
+
+  ~framed_serial_protocol() override { stop(); }
+
+private:
+  void open() override
+  {
+    m_port = new QSerialPort{m_info, this};
+    m_port->setBaudRate(spec().baudRate);
+    QObject::connect(m_port, &QSerialPort::readyRead, this, [this] {
+      const auto available = m_port->bytesAvailable();
+      if (available <= 0)
+        return;
+
+      m_buffer.resize(available);
+      const auto read = m_port->read(m_buffer.data(), available);
+      if (read > 0)
+        feed(m_buffer.data(), read);
+    });
+
+    if (!m_port->open(QIODevice::ReadWrite))
+      qDebug() << "Could not open serial port" << m_info.portName() << m_port->errorString();
+  }
+
+  void close() override
+  {
+    delete m_port;
+    m_port = nullptr;
+  }
+
+  void write(const char* data, std::size_t size) override
+  {
+    if (m_port && m_port->isOpen())
+      m_port->write(data, size);
+  }
+
+  QSerialPortInfo m_info;
+  QSerialPort* m_port{};
+  std::vector<char> m_buffer;
+};
+}
+#endif
+
 SerialDevice::SerialDevice(const Device::DeviceSettings& settings)
     : OwningDeviceInterface{settings}
 {
@@ -28,6 +87,12 @@ SerialDevice::SerialDevice(const Device::DeviceSettings& settings)
   m_capas.canSetProperties = false;
 }
 
+SerialDevice::~SerialDevice()
+{
+  if (m_output)
+    m_output->stop();
+}
+
 bool SerialDevice::reconnect()
 {
   disconnect();
@@ -35,10 +100,30 @@ bool SerialDevice::reconnect()
   try
   {
     const auto& stgs = settings().deviceSpecificSettings.value<SerialSpecificSettings>();
+    const auto code = stgs.text.toUtf8();
+
+#if __has_include(<QQmlEngine>)
+    // The packets are decoded natively if the script declares their layout
+    if (auto spec = readFramingSpec(code))
+    {
+      auto proto = std::make_unique<framed_serial_protocol>(std::move(*spec), code, stgs.port);
+      auto framed = proto.get();
 
-    m_dev = std::make_unique<ossia::net::serial_device>(
-        std::make_unique<ossia::net::serial_protocol>(stgs.text.toUtf8(), stgs.port),
-        settings().name.toStdString());
+      m_dev = std::make_unique<ossia::net::generic_device>(
+          std::move(proto), settings().name.toStdString());
+      m_framed = framed;
+    }
+    else
+#endif
+    {
+      auto proto = std::make_unique<AsyncOutputProtocol>(
+          std::make_unique<ossia::net::serial_protocol>(code, stgs.port));
+      auto output = proto.get();
+
+      m_dev = std::make_unique<ossia::net::serial_device>(
+          std::move(proto), settings().name.toStdString());
+      m_output = output;
+    }
 
     deviceChanged(nullptr, m_dev.get());
 
@@ -57,5 +142,22 @@ bool SerialDevice::reconnect()
 
   return connected();
 }
+
+void SerialDevice::disconnect()
+{
+  // The values waiting to be sent refer to the parameters of the device
+  if (m_output)
+  {
+    m_output->stop();
+    m_output = nullptr;
+  }
+  // The reader thread sets the values of the parameters
+  if (m_framed)
+  {
+    m_framed->stop();
+    m_framed = nullptr;
+  }
+  OwningDeviceInterface::disconnect();
+}
 }
 #endif
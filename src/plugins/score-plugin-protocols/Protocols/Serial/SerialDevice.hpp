@@ -5,12 +5,20 @@
 
 namespace Protocols
 {
+class AsyncOutputProtocol;
+class FramedProtocol;
 class SerialDevice final : public Device::OwningDeviceInterface
 {
 public:
   SerialDevice(const Device::DeviceSettings& settings);
+  ~SerialDevice() override;
 
   bool reconnect() override;
+  void disconnect() override;
+
+private:
+  AsyncOutputProtocol* m_output{};
+  FramedProtocol* m_framed{};
 };
 }
 #endif
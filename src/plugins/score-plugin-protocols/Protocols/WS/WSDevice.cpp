@@ -5,16 +5,78 @@
 #include <Device/Protocol/DeviceSettings.hpp>
 #include <Explorer/DeviceList.hpp>
 #include <Explorer/DeviceLogging.hpp>
+#include <Protocols/AsyncOutputProtocol.hpp>
 #include <Protocols/WS/WSSpecificSettings.hpp>
 
 #include <ossia-qt/websocket-generic-client/ws_generic_client_protocol.hpp>
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/generic/generic_parameter.hpp>
 
+#if __has_include(<QQmlEngine>)
+#include <Protocols/Framing/FramedProtocol.hpp>
+
+#include <QWebSocket>
+#endif
+
 #include <memory>
 
 namespace Protocols
 {
+#if __has_include(<QQmlEngine>)
+namespace
+{
+// Binary and text messages go through the same decoder: a message can
+// contain several frames, or a frame span several messages.
+class framed_ws_protocol final : public FramedProtocol
+{
+public:
+  framed_ws_protocol(FramingSpec spec, const QByteArray& code, const QString& address)
+      : FramedProtocol{std::move(spec), code}, m_address{address}
+  {
+  }
+
+  ~framed_ws_protocol() override { stop(); }
+
+private:
+  void open() override
+  {
+    m_socket = new QWebSocket{QString{}, QWebSocketProtocol::VersionLatest, this};
+    QObject::connect(
+        m_socket, &QWebSocket::binaryMessageReceived, this, [this](const QByteArray& msg) {
+          feed(msg.constData(), msg.size());
+        });
+    QObject::connect(
+        m_socket, &QWebSocket::textMessageReceived, this, [this](const QString& msg) {
+          const auto data = msg.toUtf8();
+          feed(data.constData(), data.size());
+        });
+    m_socket->open(QUrl{m_address});
+  }
+
+  void close() override
+  {
+    delete m_socket;
+    m_socket = nullptr;
+  }
+
+  // Text frames are sent as text messages
+  void write(const char* data, std::size_t size) override
+  {
+    if (!m_socket)
+      return;
+
+    if (spec().separator)
+      m_socket->sendTextMessage(QString::fromUtf8(data, size));
+    else
+      m_socket->sendBinaryMessage(QByteArray{data, int(size)});
+  }
+
+  QString m_address;
+  QWebSocket* m_socket{};
+};
+}
+#endif
+
 WSDevice::WSDevice(const Device::DeviceSettings& settings) : OwningDeviceInterface{settings}
 {
   m_capas.canRefreshTree = true;
@@ -25,6 +87,12 @@ WSDevice::WSDevice(const Device::DeviceSettings& settings) : OwningDeviceInterfa
   m_capas.canSetProperties = false;
 }
 
+WSDevice::~WSDevice()
+{
+  if (m_output)
+    m_output->stop();
+}
+
 bool WSDevice::reconnect()
 {
   disconnect();
@@ -32,11 +100,30 @@ bool WSDevice::reconnect()
   try
   {
     auto stgs = settings().deviceSpecificSettings.value<WSSpecificSettings>();
+    const auto code = stgs.text.toUtf8();
+
+#if __has_include(<QQmlEngine>)
+    // The messages are decoded natively if the script declares their layout
+    if (auto spec = readFramingSpec(code))
+    {
+      auto proto = std::make_unique<framed_ws_protocol>(std::move(*spec), code, stgs.address);
+      auto framed = proto.get();
 
-    m_dev = std::make_unique<ossia::net::ws_generic_client_device>(
-        std::make_unique<ossia::net::ws_generic_client_protocol>(
-            stgs.address.toUtf8(), stgs.text.toUtf8()),
-        settings().name.toStdString());
+      m_dev = std::make_unique<ossia::net::generic_device>(
+          std::move(proto), settings().name.toStdString());
+      m_framed = framed;
+    }
+    else
+#endif
+    {
+      auto proto = std::make_unique<AsyncOutputProtocol>(
+          std::make_unique<ossia::net::ws_generic_client_protocol>(stgs.address.toUtf8(), code));
+      auto output = proto.get();
+
+      m_dev = std::make_unique<ossia::net::ws_generic_client_device>(
+          std::move(proto), settings().name.toStdString());
+      m_output = output;
+    }
 
     enableCallbacks();
 
@@ -55,4 +142,21 @@ bool WSDevice::reconnect()
 
   return connected();
 }
+
+void WSDevice::disconnect()
+{
+  // The values waiting to be sent refer to the parameters of the device
+  if (m_output)
+  {
+    m_output->stop();
+    m_output = nullptr;
+  }
+  // The reader thread sets the values of the parameters
+  if (m_framed)
+  {
+    m_framed->stop();
+    m_framed = nullptr;
+  }
+  OwningDeviceInterface::disconnect();
+}
 }
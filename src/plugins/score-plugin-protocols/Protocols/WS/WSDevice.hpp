@@ -3,11 +3,19 @@
 
 namespace Protocols
 {
+class AsyncOutputProtocol;
+class FramedProtocol;
 class WSDevice final : public Device::OwningDeviceInterface
 {
 public:
   WSDevice(const Device::DeviceSettings& settings);
+  ~WSDevice() override;
 
   bool reconnect() override;
+  void disconnect() override;
+
+private:
+  AsyncOutputProtocol* m_output{};
+  FramedProtocol* m_framed{};
 };
 }
@@ -83,25 +83,23 @@ ObjectMenuActions::ObjectMenuActions(ScenarioApplicationPlugin* parent)
   m_copyContent->setShortcut(QKeySequence::Copy);
   m_copyContent->setShortcutContext(Qt::ApplicationShortcut);
   connect(m_copyContent, &QAction::triggered, [this]() {
-    JSONReader r;
-    copySelectedElementsToJson(r);
-    if (r.empty())
+    auto elements = copySelectedElements();
+    if (!elements)
       return;
 
     auto clippy = QApplication::clipboard();
-    clippy->setText(r.toString());
+    clippy->setMimeData(new ScenarioMimeData{std::move(elements)});
   });
 
   m_cutContent = new QAction{tr("Cut"), this};
   m_cutContent->setShortcut(QKeySequence::Cut);
   m_cutContent->setShortcutContext(Qt::ApplicationShortcut);
   connect(m_cutContent, &QAction::triggered, [this] {
-    JSONReader r;
-    cutSelectedElementsToJson(r);
-    if (r.empty())
+    auto elements = cutSelectedElements();
+    if (!elements)
       return;
     auto clippy = QApplication::clipboard();
-    clippy->setText(r.toString());
+    clippy->setMimeData(new ScenarioMimeData{std::move(elements)});
   });
 
   m_pasteElements = new QAction{tr("Paste elements"), this};
@@ -127,7 +125,10 @@ ObjectMenuActions::ObjectMenuActions(ScenarioApplicationPlugin* parent)
       sv_pt = sv.mapToScene(sv.boundingRect().center());
     }
     auto pt = pres->toScenarioPoint(sv_pt);
-    pasteElements(readJson(QApplication::clipboard()->text().toUtf8()), pt);
+    if (auto elements = clipboardElements())
+      pasteElements(*elements, pt);
+    else
+      pasteElements(readJson(QApplication::clipboard()->text().toUtf8()), pt);
   });
 
   m_pasteElementsAfter = new QAction{tr("Paste (after)"), this};
@@ -365,9 +366,11 @@ void ObjectMenuActions::setupContextMenu(Process::LayerContextMenuManager& ctxm)
         pasteElements->setShortcut(QKeySequence::Paste);
         pasteElements->setShortcutContext(Qt::WidgetWithChildrenShortcut);
         connect(pasteElements, &QAction::triggered, [&, scenePoint]() {
-          this->pasteElements(
-              readJson(QApplication::clipboard()->text().toUtf8()),
-              scenario.toScenarioPoint(scenario.view().mapFromScene(scenePoint)));
+          auto pt = scenario.toScenarioPoint(scenario.view().mapFromScene(scenePoint));
+          if (auto elements = clipboardElements())
+            this->pasteElements(*elements, pt);
+          else
+            this->pasteElements(readJson(QApplication::clipboard()->text().toUtf8()), pt);
         });
         menu.addAction(pasteElements);
 
@@ -404,11 +407,21 @@ void ObjectMenuActions::copySelectedElementsToJson(JSONReader& r)
   }
 }
 
-void ObjectMenuActions::cutSelectedElementsToJson(JSONReader& r)
+std::shared_ptr<const CopiedScenarioElements> ObjectMenuActions::copySelectedElements()
 {
-  copySelectedElementsToJson(r);
-  if (r.empty())
-    return;
+  const auto& ctx = m_parent->currentDocument()->context();
+  if (auto si = focusedScenarioInterface(ctx))
+  {
+    return Scenario::copySelectedElements(*const_cast<ScenarioInterface*>(si), ctx);
+  }
+  return {};
+}
+
+std::shared_ptr<const CopiedScenarioElements> ObjectMenuActions::cutSelectedElements()
+{
+  auto elements = copySelectedElements();
+  if (!elements)
+    return {};
 
   auto& ctx = m_parent->currentDocument()->context();
 
@@ -420,6 +433,8 @@ void ObjectMenuActions::cutSelectedElementsToJson(JSONReader& r)
   {
     Scenario::clearContentFromSelection(*si, ctx);
   }
+
+  return elements;
 }
 
 void ObjectMenuActions::pasteElements(const rapidjson::Value& obj, const Scenario::Point& origin)
@@ -442,6 +457,23 @@ void ObjectMenuActions::pasteElements(const rapidjson::Value& obj, const Scenari
   dispatcher().submit(cmd);
 }
 
+void ObjectMenuActions::pasteElements(
+    const CopiedScenarioElements& elements,
+    const Scenario::Point& origin)
+{
+  if (elements.timesyncs.empty())
+    return;
+
+  auto pres = m_parent->focusedPresenter();
+  if (!pres)
+    return;
+
+  auto& sm = static_cast<const Scenario::ProcessModel&>(pres->model());
+  auto cmd = new Command::ScenarioPasteElements(sm, elements, origin);
+
+  dispatcher().submit(cmd);
+}
+
 void ObjectMenuActions::pasteElementsAfter(
     const rapidjson::Value& obj,
     const Scenario::Point& origin,
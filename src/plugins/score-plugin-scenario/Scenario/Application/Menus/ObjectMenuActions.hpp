@@ -7,9 +7,12 @@
 #include <score/command/Dispatchers/CommandDispatcher.hpp>
 #include <score/selection/Selection.hpp>
 
+#include <memory>
+
 namespace Scenario
 {
 struct Point;
+struct CopiedScenarioElements;
 class ScenarioApplicationPlugin;
 class ScenarioDocumentModel;
 class ScenarioDocumentPresenter;
@@ -28,8 +31,10 @@ public:
 
 private:
   void copySelectedElementsToJson(JSONReader& r);
-  void cutSelectedElementsToJson(JSONReader& r);
+  std::shared_ptr<const CopiedScenarioElements> copySelectedElements();
+  std::shared_ptr<const CopiedScenarioElements> cutSelectedElements();
   void pasteElements(const rapidjson::Value& obj, const Scenario::Point& origin);
+  void pasteElements(const CopiedScenarioElements& elements, const Scenario::Point& origin);
   void pasteElementsAfter(
       const rapidjson::Value& obj,
       const Scenario::Point& origin,
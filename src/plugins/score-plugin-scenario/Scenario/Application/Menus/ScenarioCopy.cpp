@@ -5,6 +5,7 @@
 #include <Dataflow/Commands/CableHelpers.hpp>
 #include <Process/Dataflow/Cable.hpp>
 #include <Scenario/Document/BaseScenario/BaseScenario.hpp>
+#include <Scenario/Document/CommentBlock/CommentBlockModel.hpp>
 #include <Scenario/Document/Event/EventModel.hpp>
 #include <Scenario/Document/Interval/IntervalModel.hpp>
 #include <Scenario/Document/ScenarioDocument/ScenarioDocumentModel.hpp>
@@ -14,20 +15,26 @@
 #include <Scenario/Process/Algorithms/ProcessPolicy.hpp>
 #include <Scenario/Process/ScenarioModel.hpp>
 
+#include <score/application/ApplicationContext.hpp>
 #include <score/document/DocumentContext.hpp>
 #include <score/model/EntityMap.hpp>
 #include <score/model/EntityMapSerialization.hpp>
 #include <score/model/EntitySerialization.hpp>
 #include <score/model/Identifier.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
 #include <score/serialization/VisitorCommon.hpp>
 #include <score/tools/std/Optional.hpp>
 
 #include <core/document/Document.hpp>
+#include <core/presenter/DocumentManager.hpp>
 
 #include <ossia/detail/algorithms.hpp>
 #include <ossia/detail/ptr_set.hpp>
 #include <ossia/detail/thread.hpp>
 
+#include <QClipboard>
+#include <QGuiApplication>
+
 #include <vector>
 namespace Scenario
 {
@@ -111,8 +118,9 @@ Dataflow::SerializedCables cablesToCopy(
   return copiedCables;
 }
 
-template <typename Scenario_T>
-void copySelected(JSONReader& r, const Scenario_T& sm, CategorisedScenario& cs, QObject* parent)
+// Calls f with the intervals, events, time syncs, states and cables to copy
+template <typename Scenario_T, typename F>
+void copySelected(const Scenario_T& sm, CategorisedScenario& cs, QObject* parent, F&& f)
 {
   std::vector<Path<Scenario::IntervalModel>> itv_paths;
   for (const IntervalModel* interval : cs.selectedIntervals)
@@ -216,11 +224,11 @@ void copySelected(JSONReader& r, const Scenario_T& sm, CategorisedScenario& cs,
     copiedStates.push_back(clone_st);
   }
 
-  r.obj["Intervals"] = cs.selectedIntervals;
-  r.obj["Events"] = copiedEvents;
-  r.obj["TimeNodes"] = copiedTimeSyncs;
-  r.obj["States"] = copiedStates;
-  r.obj["Cables"] = cablesToCopy(cs.selectedIntervals, itv_paths, ctx);
+  f(cs.selectedIntervals,
+    copiedEvents,
+    copiedTimeSyncs,
+    copiedStates,
+    cablesToCopy(cs.selectedIntervals, itv_paths, ctx));
 
   for (auto elt : copiedTimeSyncs)
     delete elt;
@@ -230,6 +238,59 @@ void copySelected(JSONReader& r, const Scenario_T& sm, CategorisedScenario& cs,
     delete elt;
 }
 
+template <typename Scenario_T>
+void copySelected(JSONReader& r, const Scenario_T& sm, CategorisedScenario& cs, QObject* parent)
+{
+  copySelected(
+      sm,
+      cs,
+      parent,
+      [&](const auto& intervals,
+          const auto& events,
+          const auto& timesyncs,
+          const auto& states,
+          const auto& cables) {
+        r.obj["Intervals"] = intervals;
+        r.obj["Events"] = events;
+        r.obj["TimeNodes"] = timesyncs;
+        r.obj["States"] = states;
+        r.obj["Cables"] = cables;
+      });
+}
+
+template <typename T>
+std::vector<QByteArray> marshallElements(const std::vector<T*>& elements)
+{
+  std::vector<QByteArray> res;
+  res.reserve(elements.size());
+  for (auto elt : elements)
+    res.push_back(score::marshall<DataStream>(*elt));
+  return res;
+}
+
+template <typename Scenario_T>
+std::shared_ptr<CopiedScenarioElements>
+copySelected(const Scenario_T& sm, CategorisedScenario& cs, QObject* parent)
+{
+  auto res = std::make_shared<CopiedScenarioElements>();
+  copySelected(
+      sm,
+      cs,
+      parent,
+      [&](const auto& intervals,
+          const auto& events,
+          const auto& timesyncs,
+          const auto& states,
+          const auto& cables) {
+        res->intervals = marshallElements(intervals);
+        res->events = marshallElements(events);
+        res->timesyncs = marshallElements(timesyncs);
+        res->states = marshallElements(states);
+        res->cables = cables;
+      });
+  return res;
+}
+
 void copyProcess(JSONReader& r, const Process::ProcessModel& proc)
 {
   const auto& ctx = score::IDocument::documentContext(proc);
@@ -352,6 +413,149 @@ CategorisedScenario::CategorisedScenario(const Selection& sm)
   }
 }
 
+bool CopiedScenarioElements::empty() const noexcept
+{
+  return intervals.empty() && events.empty() && timesyncs.empty() && states.empty()
+         && comments.empty();
+}
+
+void CopiedScenarioElements::toJson(JSONReader& r, const score::DocumentContext& ctx) const
+{
+  QObject parent;
+  auto load = [&](const std::vector<QByteArray>& data, auto make) {
+    std::vector<decltype(make(std::declval<DataStream::Deserializer&>()))> res;
+    res.reserve(data.size());
+    for (const auto& elt : data)
+    {
+      DataStream::Deserializer vis{elt};
+      res.push_back(make(vis));
+    }
+    return res;
+  };
+
+  auto itvs = load(intervals, [&](auto& vis) { return new IntervalModel{vis, ctx, &parent}; });
+  auto evs = load(events, [&](auto& vis) { return new EventModel{vis, nullptr}; });
+  auto tss = load(timesyncs, [&](auto& vis) { return new TimeSyncModel{vis, nullptr}; });
+  auto sts = load(states, [&](auto& vis) { return new StateModel{vis, ctx, &parent}; });
+  auto cmts = load(comments, [&](auto& vis) { return new CommentBlockModel{vis, nullptr}; });
+
+  r.stream.StartObject();
+  r.obj["Intervals"] = itvs;
+  r.obj["Events"] = evs;
+  r.obj["TimeNodes"] = tss;
+  r.obj["States"] = sts;
+  r.obj["Cables"] = cables;
+  r.obj["Comments"] = cmts;
+  r.stream.EndObject();
+
+  for (auto elt : itvs)
+    delete elt;
+  for (auto elt : evs)
+    delete elt;
+  for (auto elt : tss)
+    delete elt;
+  for (auto elt : sts)
+    delete elt;
+  for (auto elt : cmts)
+    delete elt;
+}
+
+std::shared_ptr<const CopiedScenarioElements>
+copySelectedElements(ScenarioInterface& si, const score::DocumentContext& ctx)
+{
+  std::shared_ptr<CopiedScenarioElements> res;
+  auto si_obj = dynamic_cast<QObject*>(&si);
+  if (auto sm = dynamic_cast<const Scenario::ProcessModel*>(&si))
+  {
+    CategorisedScenario cat{*sm};
+    res = copySelected(*sm, cat, const_cast<Scenario::ProcessModel*>(sm));
+    res->comments = marshallElements(selectedElements(sm->comments));
+  }
+  else if (auto bsm = dynamic_cast<const Scenario::BaseScenarioContainer*>(&si))
+  {
+    CategorisedScenario cat{*bsm};
+    res = copySelected(*bsm, cat, si_obj);
+  }
+  else
+  {
+    // Full-view copy
+    auto& bem = score::IDocument::modelDelegate<Scenario::ScenarioDocumentModel>(ctx.document);
+    if (!bem.baseScenario().selectedChildren().empty())
+    {
+      CategorisedScenario cat{bem.baseScenario()};
+      res = copySelected(bem.baseScenario(), cat, &bem.baseScenario());
+    }
+  }
+
+  if (!res || res->empty())
+    return {};
+  res->document = &ctx.document;
+  return res;
+}
+
+ScenarioMimeData::ScenarioMimeData(std::shared_ptr<const CopiedScenarioElements> elements)
+    : m_elements{std::move(elements)}
+{
+}
+
+ScenarioMimeData::~ScenarioMimeData() = default;
+
+QStringList ScenarioMimeData::formats() const
+{
+  return {QStringLiteral("text/plain")};
+}
+
+bool ScenarioMimeData::hasFormat(const QString& mimetype) const
+{
+  return mimetype == QLatin1String("text/plain");
+}
+
+void ScenarioMimeData::prepareJson(const score::DocumentContext& ctx) const
+{
+  if (!m_json.isEmpty())
+    return;
+
+  JSONReader r;
+  m_elements->toJson(r, m_elements->document ? m_elements->document->context() : ctx);
+  m_json = r.toString();
+}
+
+QVariant ScenarioMimeData::retrieveData(const QString& mimetype, QVariant::Type type) const
+{
+  if (!hasFormat(mimetype))
+    return {};
+
+  if (m_json.isEmpty())
+  {
+    // Another document is only used if the one the elements come from was closed
+    score::Document* doc = m_elements->document;
+    if (!doc)
+      doc = score::AppContext().documents.currentDocument();
+    if (!doc)
+      return {};
+    prepareJson(doc->context());
+  }
+
+  if (type == QVariant::ByteArray)
+    return m_json.toUtf8();
+  return m_json;
+}
+
+std::shared_ptr<const CopiedScenarioElements> clipboardElements()
+{
+  auto mime = QGuiApplication::clipboard()->mimeData();
+  if (auto scenario_mime = dynamic_cast<const ScenarioMimeData*>(mime))
+    return scenario_mime->elements();
+  return {};
+}
+
+void prepareClipboardJson(const score::DocumentContext& ctx)
+{
+  auto mime = QGuiApplication::clipboard()->mimeData();
+  if (auto scenario_mime = dynamic_cast<const ScenarioMimeData*>(mime))
+    scenario_mime->prepareJson(ctx);
+}
+
 void copySelectedElementsToJson(
     JSONReader& r,
     ScenarioInterface& si,
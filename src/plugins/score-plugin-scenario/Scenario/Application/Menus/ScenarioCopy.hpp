@@ -1,14 +1,22 @@
 #pragma once
+#include <Dataflow/Commands/CableHelpers.hpp>
+
+#include <score/serialization/JSONVisitor.hpp>
+
+#include <QByteArray>
+#include <QMimeData>
+#include <QPointer>
+
 #include <score_plugin_scenario_export.h>
 
+#include <memory>
 #include <vector>
-
-#include <score/serialization/JSONVisitor.hpp>
 class QJsonObject;
 class QObject;
 class Selection;
 namespace score
 {
+class Document;
 struct DocumentContext;
 }
 namespace Process
@@ -42,6 +50,82 @@ struct SCORE_PLUGIN_SCENARIO_EXPORT CategorisedScenario
   std::vector<const TimeSyncModel*> selectedTimeSyncs;
 };
 
+/**
+ * @brief Scenario elements copied to the clipboard.
+ *
+ * The elements are serialized in the DataStream format, which is much faster
+ * to save and load than JSON: pasting in the same process does not go through
+ * JSON at all. The JSON text is only generated if it is actually requested,
+ * e.g. by another application.
+ */
+struct SCORE_PLUGIN_SCENARIO_EXPORT CopiedScenarioElements
+{
+  std::vector<QByteArray> intervals;
+  std::vector<QByteArray> events;
+  std::vector<QByteArray> timesyncs;
+  std::vector<QByteArray> states;
+  std::vector<QByteArray> comments;
+  Dataflow::SerializedCables cables;
+
+  //! The document the elements were copied from
+  QPointer<score::Document> document;
+
+  bool empty() const noexcept;
+
+  /**
+   * @brief Same JSON as copySelectedElementsToJson.
+   *
+   * The elements are loaded under a temporary parent which is not part of any
+   * document: ctx is only needed to create them, and does not have to be the
+   * document they were copied from.
+   */
+  void toJson(JSONReader& r, const score::DocumentContext& ctx) const;
+};
+
+/**
+ * @brief Clipboard content for copied scenario elements.
+ *
+ * Shares the copied elements, and only generates the JSON text when it is
+ * requested.
+ */
+class SCORE_PLUGIN_SCENARIO_EXPORT ScenarioMimeData final : public QMimeData
+{
+public:
+  explicit ScenarioMimeData(std::shared_ptr<const CopiedScenarioElements> elements);
+  ~ScenarioMimeData() override;
+
+  const std::shared_ptr<const CopiedScenarioElements>& elements() const noexcept
+  {
+    return m_elements;
+  }
+
+  QStringList formats() const override;
+  bool hasFormat(const QString& mimetype) const override;
+
+  /**
+   * @brief Generates the JSON text if it was not already.
+   *
+   * Uses the document the elements were copied from if it is still open,
+   * else ctx.
+   */
+  void prepareJson(const score::DocumentContext& ctx) const;
+
+protected:
+  QVariant retrieveData(const QString& mimetype, QVariant::Type type) const override;
+
+private:
+  std::shared_ptr<const CopiedScenarioElements> m_elements;
+  mutable QString m_json;
+};
+
+//! The elements in the clipboard, if they were copied from this instance of score
+SCORE_PLUGIN_SCENARIO_EXPORT
+std::shared_ptr<const CopiedScenarioElements> clipboardElements();
+
+//! Generates the JSON text of the clipboard, while a document is still open to create the elements
+SCORE_PLUGIN_SCENARIO_EXPORT
+void prepareClipboardJson(const score::DocumentContext& ctx);
+
 void copyBaseInterval(JSONReader&, const IntervalModel&);
 
 SCORE_PLUGIN_SCENARIO_EXPORT
@@ -81,4 +165,9 @@ void copySelectedElementsToJson(
     JSONReader&,
     ScenarioInterface& s,
     const score::DocumentContext& ctx);
+
+//! Returns nullptr if nothing is selected
+SCORE_PLUGIN_SCENARIO_EXPORT
+std::shared_ptr<const CopiedScenarioElements>
+copySelectedElements(ScenarioInterface& s, const score::DocumentContext& ctx);
 }
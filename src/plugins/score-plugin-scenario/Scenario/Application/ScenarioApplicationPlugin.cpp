@@ -14,6 +14,7 @@
 #include <Scenario/Application/Drops/AutomationDropHandler.hpp>
 #include <Scenario/Application/Menus/ObjectMenuActions.hpp>
 #include <Scenario/Application/Menus/ScenarioContextMenuManager.hpp>
+#include <Scenario/Application/Menus/ScenarioCopy.hpp>
 #include <Scenario/Application/ScenarioActions.hpp>
 #include <Scenario/Application/ScenarioEditionSettings.hpp>
 #include <Scenario/Document/CommentBlock/CommentBlockModel.hpp>
@@ -311,7 +312,13 @@ void ScenarioApplicationPlugin::on_documentChanged(
   m_editionSettings.setExecution(false);
 
   if (!newdoc)
+  {
+    // The last document is being closed: copied elements could not be
+    // created anymore to generate the clipboard text.
+    if (olddoc)
+      prepareClipboardJson(olddoc->context());
     return;
+  }
 
   // Load cables
   auto& model = score::IDocument::modelDelegate<Scenario::ScenarioDocumentModel>(*newdoc);
@@ -1,4 +1,5 @@
 #pragma once
+#include <Scenario/Application/Menus/ScenarioCopy.hpp>
 #include <Scenario/Process/ScenarioModel.hpp>
 
 #include <score/tools/IdentifierGeneration.hpp>
@@ -70,13 +71,40 @@ struct ScenarioBeingCopied
       }
     }
 
-    // We generate identifiers for the forthcoming elements
-    interval_ids
-        = getStrongIdRange2<IntervalModel>(intervals.size(), scenario.intervals, intervals);
-    timesync_ids
-        = getStrongIdRange2<TimeSyncModel>(timesyncs.size(), scenario.timeSyncs, timesyncs);
-    event_ids = getStrongIdRange2<EventModel>(events.size(), scenario.events, events);
-    state_ids = getStrongIdRange2<StateModel>(states.size(), scenario.states, states);
+    generateIds(scenario);
+  }
+
+  //! From elements copied in this process: no JSON is involved
+  ScenarioBeingCopied(
+      const CopiedScenarioElements& elements,
+      const Scenario::ProcessModel& scenario,
+      const score::DocumentContext& ctx)
+  {
+    intervals.reserve(elements.intervals.size());
+    for (const auto& element : elements.intervals)
+    {
+      DataStream::Deserializer vis{element};
+      intervals.emplace_back(new IntervalModel{vis, scenario.context(), (QObject*)&scenario});
+    }
+
+    timesyncs.reserve(elements.timesyncs.size());
+    for (const auto& element : elements.timesyncs)
+      timesyncs.emplace_back(new TimeSyncModel{DataStream::Deserializer{element}, nullptr});
+
+    events.reserve(elements.events.size());
+    for (const auto& element : elements.events)
+      events.emplace_back(new EventModel{DataStream::Deserializer{element}, nullptr});
+
+    states.reserve(elements.states.size());
+    for (const auto& element : elements.states)
+      states.emplace_back(new StateModel{
+          DataStream::Deserializer{element}, scenario.context(), (QObject*)&scenario});
+
+    cables.reserve(elements.cables.size());
+    for (const auto& [id, cable] : elements.cables)
+      cables.push_back(cable);
+
+    generateIds(scenario);
   }
 
   std::vector<TimeSyncModel*> timesyncs;
@@ -89,5 +117,17 @@ struct ScenarioBeingCopied
   std::vector<Id<TimeSyncModel>> timesync_ids;
   std::vector<Id<EventModel>> event_ids;
   std::vector<Id<StateModel>> state_ids;
+
+private:
+  // We generate identifiers for the forthcoming elements
+  void generateIds(const Scenario::ProcessModel& scenario)
+  {
+    interval_ids
+        = getStrongIdRange2<IntervalModel>(intervals.size(), scenario.intervals, intervals);
+    timesync_ids
+        = getStrongIdRange2<TimeSyncModel>(timesyncs.size(), scenario.timeSyncs, timesyncs);
+    event_ids = getStrongIdRange2<EventModel>(events.size(), scenario.events, events);
+    state_ids = getStrongIdRange2<StateModel>(states.size(), scenario.states, states);
+  }
 };
 }
@@ -43,10 +43,32 @@ ScenarioPasteElements::ScenarioPasteElements(
     const Scenario::ProcessModel& scenario,
     const rapidjson::Value& obj,
     const Scenario::Point& pt)
+    : ScenarioPasteElements{
+        scenario,
+        ScenarioBeingCopied{obj, scenario, score::IDocument::documentContext(scenario)},
+        pt}
+{
+}
+
+ScenarioPasteElements::ScenarioPasteElements(
+    const Scenario::ProcessModel& scenario,
+    const CopiedScenarioElements& elements,
+    const Scenario::Point& pt)
+    : ScenarioPasteElements{
+        scenario,
+        ScenarioBeingCopied{elements, scenario, score::IDocument::documentContext(scenario)},
+        pt}
+{
+}
+
+ScenarioPasteElements::ScenarioPasteElements(
+    const Scenario::ProcessModel& scenario,
+    ScenarioBeingCopied&& copied,
+    const Scenario::Point& pt)
     : m_ts{scenario}
 {
   auto& ctx = score::IDocument::documentContext(scenario);
-  auto
+  auto&
       [timesyncs,
        intervals,
        events,
@@ -56,7 +78,7 @@ ScenarioPasteElements::ScenarioPasteElements(
        timesync_ids,
        event_ids,
        state_ids]
-      = ScenarioBeingCopied{obj, scenario, ctx};
+      = copied;
 
   // We set the new ids everywhere
   {
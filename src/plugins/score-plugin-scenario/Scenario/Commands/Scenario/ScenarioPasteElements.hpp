@@ -16,6 +16,8 @@
 namespace Scenario
 {
 struct Point;
+struct CopiedScenarioElements;
+struct ScenarioBeingCopied;
 class EventModel;
 class StateModel;
 class TimeSyncModel;
@@ -32,6 +34,12 @@ public:
       const rapidjson::Value& obj,
       const Scenario::Point& pt);
 
+  //! Fast path for elements copied from this process
+  ScenarioPasteElements(
+      const Scenario::ProcessModel& path,
+      const CopiedScenarioElements& elements,
+      const Scenario::Point& pt);
+
   void undo(const score::DocumentContext& ctx) const override;
   void redo(const score::DocumentContext& ctx) const override;
 
@@ -40,6 +48,11 @@ protected:
   void deserializeImpl(DataStreamOutput&) override;
 
 private:
+  ScenarioPasteElements(
+      const Scenario::ProcessModel& path,
+      ScenarioBeingCopied&& copied,
+      const Scenario::Point& pt);
+
   Path<Scenario::ProcessModel> m_ts;
 
   // TODO std::vector...
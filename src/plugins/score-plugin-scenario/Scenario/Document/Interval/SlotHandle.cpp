@@ -44,6 +44,12 @@ void SlotPresenter::cleanup(QGraphicsScene* sc)
       delete footer;
       footer = nullptr;
     }
+    if (placeholder)
+    {
+      sc->removeItem(placeholder);
+      delete placeholder;
+      placeholder = nullptr;
+    }
   }
   else
   {
@@ -51,6 +57,8 @@ void SlotPresenter::cleanup(QGraphicsScene* sc)
     header = nullptr;
     delete footer;
     footer = nullptr;
+    delete placeholder;
+    placeholder = nullptr;
   }
 
   for (LayerData& ld : layers)
@@ -253,6 +253,41 @@ void SlotFooter::setWidth(qreal width)
   update();
 }
 
+SlotPlaceholder::SlotPlaceholder(std::function<void(SlotPlaceholder*)> onExposed, QGraphicsItem* parent)
+    : QGraphicsItem{parent}
+    , m_onExposed{std::move(onExposed)}
+{
+  this->setCacheMode(QGraphicsItem::NoCache);
+  this->setAcceptedMouseButtons(Qt::NoButton);
+}
+
+QRectF SlotPlaceholder::boundingRect() const
+{
+  return {QPointF{}, m_size};
+}
+
+void SlotPlaceholder::paint(
+    QPainter* painter,
+    const QStyleOptionGraphicsItem* option,
+    QWidget* widget)
+{
+  if (m_onExposed)
+  {
+    auto f = std::move(m_onExposed);
+    m_onExposed = {};
+    f(this);
+  }
+}
+
+void SlotPlaceholder::setSize(QSizeF sz)
+{
+  if (sz != m_size)
+  {
+    prepareGeometryChange();
+    m_size = sz;
+  }
+}
+
 AmovibleSlotFooter::AmovibleSlotFooter(
     const IntervalPresenter& slotView,
     int slotIndex,
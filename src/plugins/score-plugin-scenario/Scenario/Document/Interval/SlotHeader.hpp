@@ -6,6 +6,8 @@
 
 #include <verdigris>
 
+#include <functional>
+
 namespace Scenario
 {
 class IntervalPresenter;
@@ -92,6 +94,28 @@ private:
   void mouseReleaseEvent(QGraphicsSceneMouseEvent* event) final override;
 };
 
+/**
+ * @brief Stands for the layers of a slot until the slot is displayed.
+ *
+ * The views only paint the items which are in their visible area: the
+ * first call to paint means that the slot can be seen, and calls onExposed.
+ * The callback must not delete the item, as the scene is being painted.
+ */
+class SlotPlaceholder final : public QGraphicsItem
+{
+public:
+  SlotPlaceholder(std::function<void(SlotPlaceholder*)> onExposed, QGraphicsItem* parent);
+
+  QRectF boundingRect() const override;
+  void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+
+  void setSize(QSizeF sz);
+
+private:
+  std::function<void(SlotPlaceholder*)> m_onExposed;
+  QSizeF m_size;
+};
+
 class SlotDragOverlay final : public QObject, public QGraphicsItem
 {
   W_OBJECT(SlotDragOverlay)
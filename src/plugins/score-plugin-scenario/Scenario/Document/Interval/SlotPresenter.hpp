@@ -16,6 +16,11 @@ struct SlotPresenter
   Process::FooterDelegate* footerDelegate{};
   std::vector<LayerData> layers;
 
+  //! Present until the slot is displayed for the first time
+  SlotPlaceholder* placeholder{};
+  //! The layers are only created once the slot has been displayed
+  bool exposed{};
+
   void cleanupHeaderFooter();
   void cleanup(QGraphicsScene* sc);
 
@@ -449,7 +449,7 @@ void TemporalIntervalPresenter::on_rackVisibleChanged(bool b)
   on_rackChanged();
 }
 
-void TemporalIntervalPresenter::createSlot(int pos, const Slot& aSlt)
+void TemporalIntervalPresenter::createSlot(int pos, const Slot& aSlt, bool exposed)
 {
   if (m_model.smallViewVisible())
   {
@@ -460,6 +460,20 @@ void TemporalIntervalPresenter::createSlot(int pos, const Slot& aSlt)
     else
       p.footer = new FixedSlotFooter{*this, pos, m_view};
 
+    // The layers of the slot are created when it is displayed
+    // for the first time: a document may contain many slots and nested
+    // intervals which are never scrolled to.
+    p.exposed = exposed;
+    if (!exposed)
+    {
+      p.placeholder = new SlotPlaceholder{
+          [this](SlotPlaceholder* ph) {
+            QMetaObject::invokeMethod(
+                this, [this, ph] { on_slotExposed(ph); }, Qt::QueuedConnection);
+          },
+          m_view};
+    }
+
     // p.view = new SlotView{};
     m_slots.insert(m_slots.begin() + pos, std::move(p));
 
@@ -530,13 +544,9 @@ void TemporalIntervalPresenter::createLayer(int slot_i, const Process::ProcessMo
   if (m_model.smallViewVisible())
   {
     auto& layers = m_slots.at(slot_i).layers;
-    LayerData& ld = layers.emplace_back(&proc);
-
-    const auto def_width = m_model.duration.defaultDuration().toPixels(m_zoomRatio);
-    const auto slot_height = m_model.smallView().at(slot_i).height;
-
-    ld.updateLoops(m_context, m_zoomRatio, def_width, def_width, slot_height, m_view, this);
-    // TODO on_layerModelPutToFront(i, slot.layers.front().model());
+    // The presenter and views of the layer are only created when the
+    // process is put to front in the slot, see on_layerModelPutToFront.
+    layers.emplace_back(&proc);
 
     // TODO we should remove the connection when the layer is removed.
     // Maybe put the QMetaObject::Connection in a small struct - or just
@@ -551,6 +561,9 @@ void TemporalIntervalPresenter::createLayer(int slot_i, const Process::ProcessMo
 
       SCORE_ASSERT(!slt.layers.empty());
       LayerData& ld = slt.layers.front();
+      if (ld.count() == 0)
+        return;
+
       const auto def_width = m_model.duration.defaultDuration().toPixels(m_zoomRatio);
       const auto slot_height = m_model.smallView().at(slot_i).height;
       ld.updateLoops(
@@ -578,7 +591,7 @@ void TemporalIntervalPresenter::createLayer(int slot_i, const Process::ProcessMo
       SCORE_ASSERT(slot_i < int(m_slots.size()));
       auto& slt = this->m_slots[slot_i];
 
-      if (!slt.layers.empty())
+      if (!slt.layers.empty() && slt.layers.front().count() > 0)
       {
         LayerData& ld = slt.layers.front();
         const auto def_width = m_model.duration.defaultDuration().toPixels(m_zoomRatio);
@@ -720,6 +733,8 @@ void TemporalIntervalPresenter::updatePositions()
 
     if (sv)
     {
+      if (slot.placeholder)
+        slot.placeholder->setPos(QPointF{0., currentSlotY});
       for (LayerData& ld : slot.layers)
       {
         ld.updateYPositions(currentSlotY);
@@ -756,11 +771,20 @@ void TemporalIntervalPresenter::on_layerModelPutToFront(
     // switching...
     SlotPresenter& slt = m_slots.at(slot);
     slt.cleanupHeaderFooter();
-    for (const LayerData& ld : slt.layers)
+    for (LayerData& ld : slt.layers)
     {
       if (ld.model().id() == proc.id())
       {
-        if (auto pres = ld.mainPresenter())
+        if (ld.count() == 0 && slt.exposed)
+        {
+          const auto def_width = m_model.duration.defaultDuration().toPixels(m_zoomRatio);
+          const auto slot_height = m_model.smallView().at(slot).height;
+          ld.updateLoops(m_context, m_zoomRatio, def_width, def_width, slot_height, m_view, this);
+          updateProcessShape(slot, ld);
+        }
+
+        // The header and footer are shown even if the slot was not displayed yet
+        if (ld.count() == 0 || ld.mainPresenter())
         {
           auto factory = m_context.processList.findDefaultFactory(ld.model().concreteKey());
           ld.putToFront();
@@ -809,11 +833,38 @@ void TemporalIntervalPresenter::on_layerModelPutToBack(int slot, const Process::
   }
 }
 
+void TemporalIntervalPresenter::on_slotExposed(const SlotPlaceholder* placeholder)
+{
+  // The slot may have been removed since it was painted
+  auto it = ossia::find_if(
+      m_slots, [=](const SlotPresenter& slt) { return slt.placeholder == placeholder; });
+  if (it == m_slots.end())
+    return;
+
+  SlotPresenter& slt = *it;
+  slt.exposed = true;
+  deleteGraphicsItem(slt.placeholder);
+  slt.placeholder = nullptr;
+
+  const int i = std::distance(m_slots.begin(), it);
+  if (const auto& front = m_model.smallView().at(i).frontProcess)
+  {
+    auto proc = m_model.processes.find(*front);
+    if (proc != m_model.processes.end())
+      on_layerModelPutToFront(i, *proc);
+  }
+}
+
 void TemporalIntervalPresenter::on_rackChanged()
 {
+  // Slots which were already displayed keep their layers when recreated
+  std::vector<bool> exposed;
+  exposed.reserve(m_slots.size());
+
   // Remove existing
   for (auto& slot : m_slots)
   {
+    exposed.push_back(slot.exposed);
     slot.cleanup(m_view->scene());
   }
 
@@ -827,7 +878,7 @@ void TemporalIntervalPresenter::on_rackChanged()
     int i = 0;
     for (const auto& slt : m_model.smallView())
     {
-      createSlot(i, slt);
+      createSlot(i, slt, i < int(exposed.size()) && exposed[i]);
       i++;
     }
   }
@@ -868,7 +919,8 @@ void TemporalIntervalPresenter::on_zoomRatioChanged(ZoomRatio ratio)
       slot.headerDelegate->on_zoomRatioChanged(ratio);
     for (LayerData& ld : slot.layers)
     {
-      ld.on_zoomRatioChanged(m_context, ratio, def_width, def_width, slot_height, m_view, this);
+      if (ld.count() > 0)
+        ld.on_zoomRatioChanged(m_context, ratio, def_width, def_width, slot_height, m_view, this);
     }
     i++;
   }
@@ -896,11 +948,13 @@ void TemporalIntervalPresenter::selectedSlot(int i) const
     auto proc = m_model.getSmallViewSlot(i).frontProcess;
     if (proc)
     {
-      if (!m_slots[i].layers.empty())
+      auto it = ossia::find_if(
+          slot.layers, [&](const LayerData& ld) { return ld.model().id() == *proc; });
+      if (it != slot.layers.end())
       {
-        if(auto pres = m_slots[i].layers.front().mainPresenter())
+        if (auto pres = it->mainPresenter())
         {
-          m_context.focusDispatcher.focus(m_slots[i].layers.front().mainPresenter());
+          m_context.focusDispatcher.focus(pres);
           disp.setAndCommit({&m_model.processes.at(*proc)});
         }
         else
@@ -1007,16 +1061,26 @@ void TemporalIntervalPresenter::on_defaultDurationChanged(const TimeVal& val)
   {
     setHeaderWidth(slot, w);
     const auto slot_height = m_model.smallView()[i].height;
+    if (slot.placeholder)
+      slot.placeholder->setSize({w, slot_height});
 
     for (LayerData& ld : slot.layers)
     {
-      ld.setWidth(w, w);
-      ld.updateLoops(m_context, m_zoomRatio, w, w, slot_height, m_view, this);
+      if (ld.count() > 0)
+      {
+        ld.setWidth(w, w);
+        ld.updateLoops(m_context, m_zoomRatio, w, w, slot_height, m_view, this);
+      }
     }
 
-    if(!slot.layers.empty())
+    if (!slot.layers.empty())
     {
-      on_layerModelPutToFront(i, slot.layers.front().model());
+      if (const auto& front = m_model.smallView()[i].frontProcess)
+      {
+        auto proc = m_model.processes.find(*front);
+        if (proc != m_model.processes.end())
+          on_layerModelPutToFront(i, *proc);
+      }
     }
 
     i++;
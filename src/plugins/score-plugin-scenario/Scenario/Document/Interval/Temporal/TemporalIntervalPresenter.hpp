@@ -15,6 +15,7 @@ namespace Scenario
 {
 class EventModel;
 class SlotHeader;
+class SlotPlaceholder;
 class DefaultHeaderDelegate;
 class TemporalIntervalHeader;
 class TemporalIntervalView;
@@ -57,7 +58,7 @@ private:
   double rackHeight() const;
   double smallRackHeight() const;
 
-  void createSlot(int pos, const Slot& slt);
+  void createSlot(int pos, const Slot& slt, bool exposed = false);
   void createSmallSlot(int pos, const Slot& aSlt);
 
   void createLayer(int slot, const Process::ProcessModel& proc);
@@ -69,6 +70,7 @@ private:
   void updatePositions();
   void on_layerModelPutToFront(int slot, const Process::ProcessModel& proc);
   void on_layerModelPutToBack(int slot, const Process::ProcessModel& proc);
+  void on_slotExposed(const SlotPlaceholder* placeholder);
   void on_rackChanged();
   void on_processesChanged(const Process::ProcessModel&);
   void on_requestOverlayMenu(QPointF);
@@ -0,0 +1,123 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <Protocols/Artnet/ArtnetOutput.hpp>
+
+#include <QObject>
+#include <QUdpSocket>
+#include <QtTest>
+
+#include <chrono>
+
+using namespace std::literals;
+
+class ArtnetOutputTest : public QObject
+{
+  Q_OBJECT
+
+  static QByteArrayList receive(QUdpSocket& socket, int count)
+  {
+    QByteArrayList res;
+    while (res.size() < count)
+    {
+      if (!socket.hasPendingDatagrams() && !socket.waitForReadyRead(1000))
+        break;
+
+      QByteArray data(socket.pendingDatagramSize(), Qt::Uninitialized);
+      socket.readDatagram(data.data(), data.size());
+      res.push_back(data);
+    }
+    return res;
+  }
+
+private Q_SLOTS:
+  void test_loopback()
+  {
+    QUdpSocket socket;
+    QVERIFY(socket.bind(QHostAddress::LocalHost, 0));
+
+    Protocols::ArtnetSpecificSettings settings;
+    settings.rate = 44;
+    settings.universe = 3;
+    settings.universes = 2;
+    settings.hosts = QStringLiteral("127.0.0.1:%1").arg(socket.localPort());
+    settings.sync = true;
+
+    // The output is not started: the ticks are driven by the test
+    Protocols::ArtnetOutput output{settings};
+    const auto t0 = std::chrono::steady_clock::now();
+    const auto period = std::chrono::nanoseconds(1s) / settings.rate;
+
+    // Only the first universe changes; the second one is set to the value it already has.
+    // Each tick sends the first universe; both are sent on the first tick and after one second.
+    const int ticks = settings.rate + 2;
+    int expected = 0;
+    for (int i = 0; i < ticks; i++)
+    {
+      output.set(0, 10, i % 256);
+      output.set(1, 0, 0);
+
+      const auto now = t0 + i * period;
+      output.tick(now);
+      expected += 2; // ArtDmx and ArtSync
+      if (i == 0 || (now - t0 >= 1s && now - t0 < 1s + period))
+        expected++;
+    }
+
+    int first_count = 0;
+    int second_count = 0;
+    int sync_count = 0;
+    int prev_seq = -1;
+    QByteArray last_packet;
+
+    const auto packets = receive(socket, expected);
+    QCOMPARE(packets.size(), expected);
+    for (const QByteArray& data : packets)
+    {
+      QVERIFY(data.startsWith(QByteArray("Art-Net\0", 8)));
+      QCOMPARE(data[10], char(0));
+      QCOMPARE(data[11], char(14));
+
+      if (data[9] == 0x52)
+      {
+        QCOMPARE(data.size(), 14);
+        sync_count++;
+        continue;
+      }
+
+      QCOMPARE(data[9], char(0x50));
+      QCOMPARE(data.size(), Protocols::ArtnetOutput::packet_size);
+      QCOMPARE(data[16], char(2));
+      QCOMPARE(data[17], char(0));
+
+      const int universe = uint8_t(data[14]) | (uint8_t(data[15]) << 8);
+      if (universe == 3)
+      {
+        const int seq = uint8_t(data[12]);
+        if (prev_seq != -1)
+          QCOMPARE(seq, prev_seq == 255 ? 1 : prev_seq + 1);
+        prev_seq = seq;
+
+        first_count++;
+        last_packet = data;
+      }
+      else
+      {
+        QCOMPARE(universe, 4);
+        second_count++;
+      }
+    }
+
+    QCOMPARE(first_count, ticks);
+    QCOMPARE(second_count, 2);
+    QCOMPARE(sync_count, ticks);
+    QCOMPARE(
+        int(uint8_t(last_packet[Protocols::ArtnetOutput::header_size + 10])), (ticks - 1) % 256);
+
+    // Nothing is sent when nothing changed
+    output.tick(t0 + ticks * period);
+    QVERIFY(!socket.waitForReadyRead(100));
+  }
+};
+
+QTEST_GUILESS_MAIN(ArtnetOutputTest)
+#include "ArtnetOutputTest.moc"
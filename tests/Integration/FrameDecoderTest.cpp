@@ -0,0 +1,151 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <Protocols/Framing/FrameDecoder.hpp>
+
+#include <QObject>
+#include <QtTest>
+
+#include <string>
+#include <vector>
+
+using namespace Protocols;
+
+class FrameDecoderTest : public QObject
+{
+  Q_OBJECT
+
+  static std::string frame(const FramingSpec& spec, const std::string& payload)
+  {
+    std::string out;
+    appendFrame(spec, payload.data(), payload.size(), out);
+    return out;
+  }
+
+  static std::vector<std::vector<ossia::value>>
+  decodeAll(FrameDecoder& dec, const std::string& data, std::size_t chunk)
+  {
+    std::vector<std::vector<ossia::value>> res;
+    std::vector<ossia::value> values;
+    for (std::size_t i = 0; i < data.size(); i += chunk)
+    {
+      dec.feed(data.data() + i, std::min(chunk, data.size() - i), [&](const char* f, std::size_t n) {
+        if (dec.decode(f, n, values))
+          res.push_back(values);
+      });
+    }
+    return res;
+  }
+
+private Q_SLOTS:
+  void test_text_lines()
+  {
+    FramingSpec spec;
+    spec.separator = ',';
+    spec.fields = {{"/x", FrameField::Float32}, {"/n", FrameField::Int32}, {"/s", FrameField::String}};
+
+    FrameDecoder dec{spec};
+    const auto res = decodeAll(dec, "1.5,2,foo\r\n-3,4,bar\n\n5,6", 3);
+
+    QCOMPARE(int(res.size()), 2);
+    QCOMPARE(res[0][0], ossia::value{1.5f});
+    QCOMPARE(res[0][1], ossia::value{2});
+    QCOMPARE(res[0][2], ossia::value{std::string("foo")});
+    QCOMPARE(res[1][0], ossia::value{-3.f});
+    QCOMPARE(res[1][2], ossia::value{std::string("bar")});
+    QCOMPARE(dec.errors(), uint64_t(0));
+  }
+
+  void test_length_prefixed()
+  {
+    FramingSpec spec;
+    spec.framing = Framing::LengthPrefixed;
+    spec.lengthSize = 2;
+    spec.bigEndian = true;
+    spec.fields = {{"/a", FrameField::UInt16}, {"/b", FrameField::Int8, 3, 0.5}};
+
+    FrameDecoder dec{spec};
+    const std::string frame("\x00\x04\x12\x34\x00\xFE", 6);
+    const auto res = decodeAll(dec, frame + frame, 1);
+
+    QCOMPARE(int(res.size()), 2);
+    QCOMPARE(res[1][0], ossia::value{0x1234});
+    QCOMPARE(res[1][1], ossia::value{-1.f});
+
+    // A size larger than the maximum means that the stream is out of sync
+    const std::string bad("\xFF\xFF", 2);
+    decodeAll(dec, bad, 2);
+    QCOMPARE(dec.errors(), uint64_t(1));
+  }
+
+  void test_slip()
+  {
+    FramingSpec spec;
+    spec.framing = Framing::SLIP;
+    spec.fields = {{"/a", FrameField::UInt16}};
+
+    FrameDecoder dec{spec};
+    // 0xC0 and 0xDB are escaped in the payload
+    const auto res = decodeAll(dec, std::string("\xC0\xDB\xDC\xDB\xDD\xC0\x01\x00\xC0", 9), 2);
+
+    QCOMPARE(int(res.size()), 2);
+    QCOMPARE(res[0][0], ossia::value{0xDBC0});
+    QCOMPARE(res[1][0], ossia::value{1});
+  }
+
+  void test_cobs()
+  {
+    FramingSpec spec;
+    spec.framing = Framing::COBS;
+    spec.fields = {{"/a", FrameField::Float32}, {"/b", FrameField::UInt8}};
+
+    FrameDecoder dec{spec};
+    const float f = 0.f;
+    std::string payload(reinterpret_cast<const char*>(&f), 4);
+    payload.push_back('\x07');
+
+    const auto res = decodeAll(dec, frame(spec, payload) + frame(spec, payload), 3);
+    QCOMPARE(int(res.size()), 2);
+    QCOMPARE(res[0][0], ossia::value{0.f});
+    QCOMPARE(res[0][1], ossia::value{7});
+
+    // Too short for the layout
+    decodeAll(dec, frame(spec, std::string("\x01", 1)), 1);
+    QCOMPARE(dec.frames(), uint64_t(3));
+    QCOMPARE(dec.errors(), uint64_t(1));
+  }
+
+  void test_encode()
+  {
+    FramingSpec cobs_spec;
+    cobs_spec.framing = Framing::COBS;
+    QCOMPARE(
+        frame(cobs_spec, std::string("\x11\x22\x00\x33", 4)),
+        std::string("\x03\x11\x22\x02\x33\x00", 6));
+
+    FramingSpec slip_spec;
+    slip_spec.framing = Framing::SLIP;
+    QCOMPARE(frame(slip_spec, std::string("\xC0\x01", 2)), std::string("\xDB\xDC\x01\xC0", 4));
+
+    // Binary outputs follow the endianness of the spec, after their header
+    FramingSpec binary;
+    binary.framing = Framing::LengthPrefixed;
+    binary.bigEndian = true;
+    std::string out;
+    QVERIFY(encodeFrame(binary, {"/led", FrameField::UInt16, -1, 1., "L"}, 0x1234, out));
+    QCOMPARE(out, std::string("\x03L\x12\x34", 4));
+
+    // Text outputs are written like the values which are parsed
+    FramingSpec text;
+    text.separator = ' ';
+    out.clear();
+    QVERIFY(encodeFrame(text, {"/gain", FrameField::Float32, -1, 0.5, "G"}, 1.f, out));
+    QVERIFY(encodeFrame(text, {"/n", FrameField::Int32, -1, 1., "N"}, 7, out));
+    QCOMPARE(out, std::string("G 2\nN 7\n"));
+
+    text.maxSize = 2;
+    QVERIFY(!encodeFrame(text, {"/n", FrameField::Int32, -1, 1., "N"}, 7, out));
+  }
+};
+
+QTEST_GUILESS_MAIN(FrameDecoderTest)
+#include "FrameDecoderTest.moc"
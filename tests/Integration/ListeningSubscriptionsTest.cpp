@@ -0,0 +1,177 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <Device/Protocol/ListeningSubscriptions.hpp>
+
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/local/local.hpp>
+
+#include <QObject>
+#include <QtTest>
+
+#include <vector>
+
+class ListeningSubscriptionsTest : public QObject
+{
+  Q_OBJECT
+
+  struct recorder
+  {
+    std::vector<std::pair<State::Address, ossia::value>> values;
+    void operator()(const State::Address& a, const ossia::value& v) { values.emplace_back(a, v); }
+  };
+
+  static ossia::net::parameter_base& param(ossia::net::device_base& dev, const std::string& path)
+  {
+    auto& node = ossia::net::find_or_create_node(dev.get_root_node(), path);
+    if (auto p = node.get_parameter())
+      return *p;
+    return *node.create_parameter(ossia::val_type::INT);
+  }
+
+private Q_SLOTS:
+  void test_subscribe()
+  {
+    ossia::net::generic_device dev{std::make_unique<ossia::net::multiplex_protocol>(), "dev"};
+    auto& a = param(dev, "/foo/a");
+    auto& b = param(dev, "/foo/b");
+
+    Device::ListeningSubscriptions::Sink sink;
+    recorder rec;
+    sink.connect<&recorder::operator()>(rec);
+
+    Device::ListeningSubscriptions subs{sink};
+    const State::Address addr_a{"dev", {"foo", "a"}};
+    QVERIFY(subs.subscribe(addr_a, a));
+    QVERIFY(!subs.subscribe(addr_a, a));
+    QCOMPARE(subs.parameter(addr_a), &a);
+
+    a.set_value(1);
+    b.set_value(2);
+    QCOMPARE(int(rec.values.size()), 1);
+    QCOMPARE(rec.values[0].first, addr_a);
+    QCOMPARE(rec.values[0].second, ossia::value{1});
+
+    QVERIFY(subs.unsubscribe(addr_a));
+    a.set_value(3);
+    QCOMPARE(int(rec.values.size()), 1);
+    QCOMPARE(int(subs.size()), 0);
+
+    // The entry is reused by the next subscription
+    QVERIFY(subs.subscribe(State::Address{"dev", {"foo", "b"}}, b));
+    b.set_value(4);
+    QCOMPARE(int(rec.values.size()), 2);
+    QCOMPARE(rec.values[1].first, (State::Address{"dev", {"foo", "b"}}));
+  }
+
+  void test_clear()
+  {
+    ossia::net::generic_device dev{std::make_unique<ossia::net::multiplex_protocol>(), "dev"};
+    auto& a = param(dev, "/foo/a");
+    auto& b = param(dev, "/foo/b");
+
+    Device::ListeningSubscriptions::Sink sink;
+    recorder rec;
+    sink.connect<&recorder::operator()>(rec);
+
+    Device::ListeningSubscriptions subs{sink};
+    subs.subscribe(State::Address{"dev", {"foo", "a"}}, a);
+    subs.clear();
+    QCOMPARE(int(subs.size()), 0);
+
+    // The entry of a is reused while a is still alive
+    const State::Address addr_b{"dev", {"foo", "b"}};
+    QVERIFY(subs.subscribe(addr_b, b));
+    a.set_value(1);
+    QCOMPARE(int(rec.values.size()), 0);
+
+    b.set_value(2);
+    QCOMPARE(int(rec.values.size()), 1);
+    QCOMPARE(rec.values[0].first, addr_b);
+  }
+
+  void test_release()
+  {
+    ossia::net::generic_device dev{std::make_unique<ossia::net::multiplex_protocol>(), "dev"};
+    auto& a = param(dev, "/foo/a");
+    auto& b = param(dev, "/foo/b");
+
+    Device::ListeningSubscriptions::Sink sink;
+    recorder rec;
+    sink.connect<&recorder::operator()>(rec);
+
+    Device::ListeningSubscriptions subs{sink};
+    const State::Address addr_a{"dev", {"foo", "a"}};
+    subs.subscribe(addr_a, a);
+    QVERIFY(subs.release(addr_a));
+
+    // a still holds the callback of its entry, which is not given to b
+    const State::Address addr_b{"dev", {"foo", "b"}};
+    subs.subscribe(addr_b, b);
+    a.set_value(1);
+    b.set_value(2);
+    QCOMPARE(int(rec.values.size()), 2);
+    QCOMPARE(rec.values[0].first, addr_a);
+    QCOMPARE(rec.values[1].first, addr_b);
+  }
+
+  void test_rename()
+  {
+    ossia::net::generic_device dev{std::make_unique<ossia::net::multiplex_protocol>(), "dev"};
+    auto& a = param(dev, "/foo/a");
+
+    Device::ListeningSubscriptions::Sink sink;
+    recorder rec;
+    sink.connect<&recorder::operator()>(rec);
+
+    Device::ListeningSubscriptions subs{sink};
+    subs.subscribe(State::Address{"dev", {"foo", "a"}}, a);
+    subs.rename(State::Address{"dev", {"foo"}}, "bar");
+
+    const State::Address renamed{"dev", {"bar", "a"}};
+    QVERIFY(subs.contains(renamed));
+    QVERIFY(!subs.contains(State::Address{"dev", {"foo", "a"}}));
+
+    a.set_value(5);
+    QCOMPARE(int(rec.values.size()), 1);
+    QCOMPARE(rec.values[0].first, renamed);
+
+    // The callback was replaced, not added
+    QCOMPARE(int(a.callback_count()), 1);
+
+    // The previous entry is reused without changing the renamed address
+    auto& b = param(dev, "/foo/b");
+    subs.subscribe(State::Address{"dev", {"foo", "b"}}, b);
+    a.set_value(6);
+    b.set_value(7);
+    QCOMPARE(int(rec.values.size()), 3);
+    QCOMPARE(rec.values[1].first, renamed);
+    QCOMPARE(rec.values[2].first, (State::Address{"dev", {"foo", "b"}}));
+  }
+
+  void test_subtree()
+  {
+    ossia::net::generic_device dev{std::make_unique<ossia::net::multiplex_protocol>(), "dev"};
+    for (int i = 0; i < 100; i++)
+      param(dev, "/foo/" + std::to_string(i));
+    auto& other = param(dev, "/other");
+
+    Device::ListeningSubscriptions::Sink sink;
+    Device::ListeningSubscriptions subs{sink};
+    subs.subscribe(State::Address{"dev", {"other"}}, other);
+
+    const State::Address root{"dev", {"foo"}};
+    subs.subscribeSubtree(root, *ossia::net::find_node(dev.get_root_node(), "/foo"));
+    QCOMPARE(int(subs.size()), 101);
+    QVERIFY(subs.inSubscribedSubtree(State::Address{"dev", {"foo", "new"}}));
+    QVERIFY(!subs.inSubscribedSubtree(State::Address{"dev", {"other"}}));
+
+    subs.unsubscribeSubtree(root);
+    QCOMPARE(int(subs.size()), 1);
+    QVERIFY(subs.subtrees().empty());
+    QVERIFY(!subs.inSubscribedSubtree(State::Address{"dev", {"foo", "new"}}));
+  }
+};
+
+QTEST_GUILESS_MAIN(ListeningSubscriptionsTest)
+#include "ListeningSubscriptionsTest.moc"
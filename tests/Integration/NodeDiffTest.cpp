@@ -0,0 +1,129 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <Device/Address/AddressSettings.hpp>
+#include <Device/Node/DeviceNode.hpp>
+#include <Device/Node/NodeDiff.hpp>
+
+#include <QObject>
+#include <QtTest>
+
+#include <vector>
+
+class NodeDiffTest : public QObject
+{
+  Q_OBJECT
+
+  struct recorder
+  {
+    std::vector<std::pair<int, int>> removals;
+    std::vector<std::pair<int, int>> insertions;
+    int updates{};
+    bool open{};
+
+    void aboutToRemove(Device::Node&, int first, int last)
+    {
+      QVERIFY(!open);
+      open = true;
+      removals.emplace_back(first, last);
+    }
+    void removed() { open = false; }
+    void aboutToInsert(Device::Node&, int first, int last)
+    {
+      QVERIFY(!open);
+      open = true;
+      insertions.emplace_back(first, last);
+    }
+    void inserted() { open = false; }
+    void updated(Device::Node&) { updates++; }
+  };
+
+  static Device::Node& add(Device::Node& parent, const QString& name, ossia::value v = {})
+  {
+    Device::AddressSettings s;
+    s.name = name;
+    s.value = std::move(v);
+    return parent.emplace_back(std::move(s), &parent);
+  }
+
+  static Device::Node makeDevice()
+  {
+    Device::DeviceSettings s;
+    s.name = "device";
+    return Device::Node{std::move(s), nullptr};
+  }
+
+  static QStringList names(const Device::Node& n)
+  {
+    QStringList res;
+    for (const auto& child : n)
+      res.push_back(child.displayName());
+    return res;
+  }
+
+private Q_SLOTS:
+  void test_identical()
+  {
+    auto current = makeDevice();
+    auto& foo = add(current, "foo");
+    add(foo, "bar", 1);
+
+    const auto fresh = current;
+
+    recorder rec;
+    Device::NodeDiffStatistics stats;
+    Device::applyDiff(current, fresh, rec, stats);
+
+    QVERIFY(stats.empty());
+    QVERIFY(rec.removals.empty());
+    QVERIFY(rec.insertions.empty());
+    QCOMPARE(rec.updates, 0);
+  }
+
+  void test_changes()
+  {
+    auto current = makeDevice();
+    for (auto name : {"a", "b", "c", "d", "e"})
+      add(current, name);
+    auto& c = current.childAt(2);
+    add(c, "x", 1);
+    add(c, "y", 2);
+
+    auto fresh = makeDevice();
+    add(fresh, "a");
+    auto& fc = add(fresh, "c");
+    add(fc, "x", 10);
+    add(fc, "y", 2);
+    add(fc, "z", 3);
+    add(fresh, "f");
+
+    const Device::Node* c_before = &current.childAt(2);
+
+    recorder rec;
+    Device::NodeDiffStatistics stats;
+    Device::applyDiff(current, fresh, rec, stats);
+
+    // "d" and "e" go in a single removal, then "b"
+    QCOMPARE(int(rec.removals.size()), 2);
+    QCOMPARE(rec.removals[0], std::make_pair(3, 4));
+    QCOMPARE(rec.removals[1], std::make_pair(1, 1));
+    QCOMPARE(stats.removed, 3);
+
+    // "z" under "c", "f" under the device
+    QCOMPARE(stats.added, 2);
+    QCOMPARE(int(rec.insertions.size()), 2);
+
+    // The value of "x" changed
+    QCOMPARE(stats.updated, 1);
+    QCOMPARE(rec.updates, 1);
+
+    QCOMPARE(names(current), (QStringList{"a", "c", "f"}));
+    QCOMPARE(&current.childAt(1), c_before);
+    QCOMPARE(names(current.childAt(1)), (QStringList{"x", "y", "z"}));
+    QCOMPARE(
+        current.childAt(1).childAt(0).get<Device::AddressSettings>().value, ossia::value{10});
+    QCOMPARE(current.childAt(2).parent(), &current);
+  }
+};
+
+QTEST_GUILESS_MAIN(NodeDiffTest)
+#include "NodeDiffTest.moc"
@@ -0,0 +1,133 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include <Protocols/OSC/OSCSendScheduler.hpp>
+
+#include <QObject>
+#include <QUdpSocket>
+#include <QtEndian>
+#include <QtTest>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+using namespace std::literals;
+
+class OSCSendSchedulerTest : public QObject
+{
+  Q_OBJECT
+
+  static constexpr int max_size = 512;
+
+private Q_SLOTS:
+  void test_bundles()
+  {
+    QUdpSocket socket;
+    QVERIFY(socket.bind(QHostAddress::LocalHost, 0));
+
+    Protocols::OSCSendScheduler scheduler{QStringLiteral("127.0.0.1"), socket.localPort(), 1ms, max_size};
+
+    // Only the last value of each address is sent
+    const int count = 2000;
+    for (int i = 0; i < count; i++)
+      scheduler.push("/param/" + std::to_string(i), i);
+    for (int i = 0; i < count; i++)
+      scheduler.push("/param/" + std::to_string(i), i * 2);
+    scheduler.flush();
+
+    int packets = 0;
+    int bytes = 0;
+    int messages = 0;
+    QByteArray timetag;
+    while (socket.hasPendingDatagrams())
+    {
+      QByteArray data(socket.pendingDatagramSize(), Qt::Uninitialized);
+      socket.readDatagram(data.data(), data.size());
+      packets++;
+      bytes += data.size();
+
+      QVERIFY(data.size() <= max_size);
+      QVERIFY(data.startsWith(QByteArray("#bundle\0", 8)));
+
+      // All the bundles of a flush carry the same time tag
+      if (timetag.isEmpty())
+        timetag = data.mid(8, 8);
+      QCOMPARE(data.mid(8, 8), timetag);
+
+      int pos = 16;
+      while (pos < data.size())
+      {
+        const int size = qFromBigEndian<qint32>(data.constData() + pos);
+        const QByteArray msg = data.mid(pos + 4, size);
+        pos += 4 + size;
+
+        // "/param/N" padded, ",i" padded, then the int
+        const QByteArray address{msg.constData()};
+        QVERIFY(address.startsWith("/param/"));
+        const int index = address.mid(7).toInt();
+        QCOMPARE(msg.mid(msg.size() - 8, 2), QByteArray(",i"));
+        QCOMPARE(qFromBigEndian<qint32>(msg.constData() + msg.size() - 4), index * 2);
+        messages++;
+      }
+      QCOMPARE(pos, data.size());
+    }
+
+    QCOMPARE(messages, count);
+    QVERIFY(packets < count / 10);
+    QVERIFY(bytes < count * 32);
+
+    const auto stats = scheduler.statistics();
+    QCOMPARE(stats.packets, uint64_t(packets));
+    QCOMPARE(stats.bytes, uint64_t(bytes));
+  }
+
+  void test_rates()
+  {
+    QUdpSocket socket;
+    QVERIFY(socket.bind(QHostAddress::LocalHost, 0));
+
+    Protocols::OSCSendScheduler scheduler{QStringLiteral("127.0.0.1"), socket.localPort(), 1ms};
+    scheduler.push("/foo", 1);
+    scheduler.flush();
+
+    // The rates are only computed once per second
+    QCOMPARE(scheduler.statistics().packetsPerSecond, 0.);
+    std::this_thread::sleep_for(1100ms);
+
+    scheduler.push("/foo", 2);
+    scheduler.flush();
+
+    const auto stats = scheduler.statistics();
+    QCOMPARE(stats.packets, uint64_t(2));
+    QVERIFY(stats.packetsPerSecond > 0.);
+    QVERIFY(stats.packetsPerSecond < 2.);
+    QVERIFY(stats.bytesPerSecond > 0.);
+    QVERIFY(stats.bytesPerSecond < stats.bytes);
+  }
+
+  void test_stop()
+  {
+    QUdpSocket socket;
+    QVERIFY(socket.bind(QHostAddress::LocalHost, 0));
+
+    // The batch would only be sent after one minute
+    Protocols::OSCSendScheduler scheduler{QStringLiteral("127.0.0.1"), socket.localPort(), 1min};
+    scheduler.start();
+    scheduler.push("/foo", 1.5f);
+    scheduler.push("/bar", std::string("baz"));
+    scheduler.stop();
+
+    // The pending values are sent when stopping
+    QVERIFY(socket.hasPendingDatagrams() || socket.waitForReadyRead(1000));
+    QByteArray data(socket.pendingDatagramSize(), Qt::Uninitialized);
+    socket.readDatagram(data.data(), data.size());
+
+    QVERIFY(data.startsWith(QByteArray("#bundle\0", 8)));
+    QVERIFY(data.contains(QByteArray("/foo\0\0\0\0,f\0\0", 12)));
+    QVERIFY(data.contains(QByteArray("/bar\0\0\0\0,s\0\0baz\0", 16)));
+    QVERIFY(!socket.hasPendingDatagrams());
+  }
+};
+
+QTEST_GUILESS_MAIN(OSCSendSchedulerTest)
+#include "OSCSendSchedulerTest.moc"
@@ -0,0 +1,114 @@
+#include <Device/Node/DeviceNode.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+// Namespace shaped like a large OSCQuery device:
+// 100 groups of 1000 parameters under a single device.
+static Device::Node generate_namespace(int groups, int params)
+{
+  Device::Node root;
+  Device::DeviceSettings dev;
+  dev.name = "device";
+  auto& dev_node = root.emplace_back(std::move(dev), nullptr);
+  for (int g = 0; g < groups; g++)
+  {
+    Device::AddressSettings group;
+    group.name = QStringLiteral("group.%1").arg(g);
+    auto& group_node = dev_node.emplace_back(std::move(group), nullptr);
+    for (int p = 0; p < params; p++)
+    {
+      Device::AddressSettings param;
+      param.name = QStringLiteral("param.%1").arg(p);
+      group_node.emplace_back(std::move(param), nullptr);
+    }
+  }
+  return root;
+}
+
+static std::vector<State::Address> random_addresses(int groups, int params, int count)
+{
+  std::mt19937 gen{1234};
+  std::uniform_int_distribution<int> g_dist{0, groups - 1};
+  std::uniform_int_distribution<int> p_dist{0, params - 1};
+
+  std::vector<State::Address> res;
+  for (int i = 0; i < count; i++)
+  {
+    res.push_back(State::Address{
+        "device",
+        {QStringLiteral("group.%1").arg(g_dist(gen)),
+         QStringLiteral("param.%1").arg(p_dist(gen))}});
+  }
+  return res;
+}
+
+// Previous behaviour: compare the names sibling by sibling
+static const Device::Node* linear_lookup(const Device::Node& root, const State::Address& addr)
+{
+  const Device::Node* n = Device::findChild<const Device::Node>(root, addr.device);
+  for (const auto& part : addr.path)
+  {
+    if (!n)
+      return nullptr;
+    n = Device::findChild<const Device::Node>(*n, part);
+  }
+  return n;
+}
+
+static void lookup_linear(benchmark::State& state)
+{
+  const auto root = generate_namespace(100, state.range(0) / 100);
+  const auto addrs = random_addresses(100, state.range(0) / 100, 1000);
+  for (auto _ : state)
+  {
+    for (const auto& addr : addrs)
+      benchmark::DoNotOptimize(linear_lookup(root, addr));
+  }
+  state.SetItemsProcessed(state.iterations() * addrs.size());
+}
+BENCHMARK(lookup_linear)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+static void lookup_indexed(benchmark::State& state)
+{
+  auto root = generate_namespace(100, state.range(0) / 100);
+  const auto addrs = random_addresses(100, state.range(0) / 100, 1000);
+  for (auto _ : state)
+  {
+    for (const auto& addr : addrs)
+      benchmark::DoNotOptimize(Device::try_getNodeFromAddress(root, addr));
+  }
+  state.SetItemsProcessed(state.iterations() * addrs.size());
+}
+BENCHMARK(lookup_indexed)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// Like the pathAdded handlers while a device is explored:
+// look for the parent, then append the new node.
+static void explore_indexed(benchmark::State& state)
+{
+  const int groups = 100;
+  const int params = state.range(0) / groups;
+  for (auto _ : state)
+  {
+    auto root = generate_namespace(groups, 0);
+    for (int p = 0; p < params; p++)
+    {
+      for (int g = 0; g < groups; g++)
+      {
+        auto parent = Device::try_getNodeFromAddress(
+            root, State::Address{"device", {QStringLiteral("group.%1").arg(g)}});
+        Device::AddressSettings param;
+        param.name = QStringLiteral("param.%1").arg(p);
+        if (!Device::findChild(*parent, param.name))
+          parent->emplace_back(std::move(param), nullptr);
+      }
+    }
+    benchmark::DoNotOptimize(root);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(explore_indexed)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,240 @@
+#include <benchmark/benchmark.h>
+#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// Counts the memory allocated through rapidjson, to measure the peak memory
+// actually used by each parser rather than estimating it from its containers.
+struct CountingAllocator
+{
+  static const bool kNeedFree = true;
+  static inline std::size_t current{};
+  static inline std::size_t peak{};
+
+  static void reset() noexcept { current = peak = 0; }
+
+  void* Malloc(std::size_t size)
+  {
+    if (size == 0)
+      return nullptr;
+    auto block = static_cast<char*>(std::malloc(header + size));
+    if (!block)
+      return nullptr;
+    std::memcpy(block, &size, sizeof(size));
+    current += size;
+    peak = std::max(peak, current);
+    return block + header;
+  }
+
+  void* Realloc(void* ptr, std::size_t, std::size_t newSize)
+  {
+    if (newSize == 0)
+    {
+      Free(ptr);
+      return nullptr;
+    }
+    void* res = Malloc(newSize);
+    if (ptr && res)
+    {
+      std::memcpy(res, ptr, std::min(size_of(ptr), newSize));
+      Free(ptr);
+    }
+    return res;
+  }
+
+  static void Free(void* ptr) noexcept
+  {
+    if (!ptr)
+      return;
+    current -= size_of(ptr);
+    std::free(static_cast<char*>(ptr) - header);
+  }
+
+  bool operator==(const CountingAllocator&) const noexcept { return true; }
+  bool operator!=(const CountingAllocator&) const noexcept { return false; }
+
+private:
+  static constexpr std::size_t header = alignof(std::max_align_t);
+  static std::size_t size_of(void* ptr) noexcept
+  {
+    std::size_t size;
+    std::memcpy(&size, static_cast<char*>(ptr) - header, sizeof(size));
+    return size;
+  }
+};
+
+using CountedDocument = rapidjson::GenericDocument<
+    rapidjson::UTF8<>,
+    rapidjson::MemoryPoolAllocator<CountingAllocator>,
+    CountingAllocator>;
+using CountedReader
+    = rapidjson::GenericReader<rapidjson::UTF8<>, rapidjson::UTF8<>, CountingAllocator>;
+
+// Generates a document shaped like a large .score file:
+// many intervals with curves, MIDI notes and a device tree.
+static std::string generate_document(int intervals)
+{
+  rapidjson::StringBuffer buf;
+  rapidjson::Writer<rapidjson::StringBuffer> w{buf};
+
+  w.StartObject();
+  w.Key("Document");
+  w.StartObject();
+  w.Key("Intervals");
+  w.StartArray();
+  for (int i = 0; i < intervals; i++)
+  {
+    w.StartObject();
+    w.Key("id");
+    w.Int(i);
+    w.Key("Name");
+    w.String(("Interval." + std::to_string(i)).c_str());
+    w.Key("DefaultDuration");
+    w.Int64(705600000LL * i);
+    w.Key("StartState");
+    w.Int(2 * i);
+    w.Key("EndState");
+    w.Int(2 * i + 1);
+
+    w.Key("Segments");
+    w.StartArray();
+    for (int s = 0; s < 32; s++)
+    {
+      w.StartObject();
+      w.Key("id");
+      w.Int(s);
+      w.Key("Type");
+      w.String("a8bd14e2-d7e4-47cd-b76a-6a88fa11f0d2");
+      w.Key("Start");
+      w.StartArray();
+      w.Double(s / 32.);
+      w.Double(0.5);
+      w.EndArray();
+      w.Key("End");
+      w.StartArray();
+      w.Double((s + 1) / 32.);
+      w.Double(0.25);
+      w.EndArray();
+      w.EndObject();
+    }
+    w.EndArray();
+
+    w.Key("Notes");
+    w.StartArray();
+    for (int n = 0; n < 16; n++)
+    {
+      w.StartObject();
+      w.Key("Pitch");
+      w.Int(60 + n);
+      w.Key("Velocity");
+      w.Int(100);
+      w.Key("Start");
+      w.Double(n / 16.);
+      w.Key("Duration");
+      w.Double(1. / 16.);
+      w.EndObject();
+    }
+    w.EndArray();
+    w.EndObject();
+  }
+  w.EndArray();
+  w.EndObject();
+
+  w.Key("Plugins");
+  w.StartArray();
+  w.StartObject();
+  w.Key("Devices");
+  w.StartArray();
+  for (int i = 0; i < intervals; i++)
+  {
+    w.StartObject();
+    w.Key("Address");
+    w.String(("/device/node." + std::to_string(i) + "/value").c_str());
+    w.Key("Value");
+    w.Double(i * 0.1);
+    w.EndObject();
+  }
+  w.EndArray();
+  w.EndObject();
+  w.EndArray();
+  w.EndObject();
+
+  return std::string(buf.GetString(), buf.GetSize());
+}
+
+// What readJson does: the strings are copied in the DOM
+static void parse_dom(benchmark::State& state)
+{
+  const std::string text = generate_document(state.range(0));
+  for (auto _ : state)
+  {
+    CountingAllocator::reset();
+    CountedDocument doc;
+    doc.Parse(text.data(), text.size());
+    benchmark::DoNotOptimize(doc);
+  }
+  state.counters["text_bytes"] = text.size();
+  state.counters["peak_bytes"] = text.size() + CountingAllocator::peak;
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(parse_dom)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// What readJsonInSitu does: the strings point into the file data
+static void parse_insitu(benchmark::State& state)
+{
+  const std::string text = generate_document(state.range(0));
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    std::string copy = text;
+    state.ResumeTiming();
+
+    CountingAllocator::reset();
+    CountedDocument doc;
+    doc.ParseInsitu(copy.data());
+    benchmark::DoNotOptimize(doc);
+  }
+  // The parsed text is modified in place and kept alive by the strings of the DOM
+  state.counters["text_bytes"] = text.size();
+  state.counters["peak_bytes"] = text.size() + CountingAllocator::peak;
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(parse_insitu)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+// Lower bound for a streaming reader which does not build a DOM
+struct CountingHandler : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, CountingHandler>
+{
+  std::size_t values{};
+  bool Default()
+  {
+    values++;
+    return true;
+  }
+};
+
+static void parse_sax(benchmark::State& state)
+{
+  const std::string text = generate_document(state.range(0));
+  for (auto _ : state)
+  {
+    CountingAllocator::reset();
+    CountedReader reader;
+    rapidjson::StringStream ss{text.c_str()};
+    CountingHandler handler;
+    reader.Parse(ss, handler);
+    benchmark::DoNotOptimize(handler.values);
+  }
+  state.counters["text_bytes"] = text.size();
+  state.counters["peak_bytes"] = text.size() + CountingAllocator::peak;
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(parse_sax)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+#include <Protocols/Framing/FrameDecoder.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+// A sensor board streaming six 16-bit channels per packet,
+// read back through a pseudo-terminal like a real serial port.
+static constexpr int channels = 6;
+
+static Protocols::FramingSpec make_spec(Protocols::Framing framing)
+{
+  Protocols::FramingSpec spec;
+  spec.framing = framing;
+  if (framing == Protocols::Framing::Delimiter)
+    spec.separator = ' ';
+
+  for (int i = 0; i < channels; i++)
+    spec.fields.push_back({"/sensor/" + std::to_string(i), Protocols::FrameField::Int16});
+  return spec;
+}
+
+static std::string make_stream(Protocols::Framing framing, int frames)
+{
+  const auto spec = make_spec(framing);
+  std::string stream;
+  for (int f = 0; f < frames; f++)
+  {
+    if (framing == Protocols::Framing::Delimiter)
+    {
+      for (int i = 0; i < channels; i++)
+        stream += std::to_string((f * 7 + i * 311) % 32768) + (i + 1 < channels ? " " : "\r\n");
+    }
+    else
+    {
+      std::string packet;
+      for (int i = 0; i < channels; i++)
+      {
+        const int16_t v = (f * 7 + i * 311) % 32768;
+        packet.push_back(char(v & 0xFF));
+        packet.push_back(char(v >> 8));
+      }
+      Protocols::appendFrame(spec, packet.data(), packet.size(), stream);
+    }
+  }
+  return stream;
+}
+
+static void decode_pty(benchmark::State& state, Protocols::Framing framing)
+{
+  const int frames = state.range(0);
+  const auto stream = make_stream(framing, frames);
+
+  int master{}, slave{};
+  if (openpty(&master, &slave, nullptr, nullptr, nullptr) != 0)
+  {
+    state.SkipWithError("openpty failed");
+    return;
+  }
+
+  termios tio;
+  tcgetattr(slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave, TCSANOW, &tio);
+
+  std::vector<char> buffer(4096);
+  std::vector<ossia::value> values;
+  int64_t decoded = 0;
+
+  for (auto _ : state)
+  {
+    Protocols::FrameDecoder decoder{make_spec(framing)};
+    std::thread writer{[&] {
+      std::size_t written = 0;
+      while (written < stream.size())
+      {
+        const auto res = ::write(master, stream.data() + written, stream.size() - written);
+        if (res <= 0)
+          break;
+        written += res;
+      }
+    }};
+
+    std::size_t read = 0;
+    while (read < stream.size())
+    {
+      const auto res = ::read(slave, buffer.data(), buffer.size());
+      if (res <= 0)
+        break;
+      read += res;
+
+      decoder.feed(buffer.data(), res, [&](const char* frame, std::size_t size) {
+        if (decoder.decode(frame, size, values))
+          decoded++;
+      });
+    }
+    writer.join();
+  }
+
+  close(slave);
+  close(master);
+  state.SetItemsProcessed(decoded);
+  state.SetBytesProcessed(state.iterations() * stream.size());
+}
+
+static void decode_pty_text(benchmark::State& state)
+{
+  decode_pty(state, Protocols::Framing::Delimiter);
+}
+BENCHMARK(decode_pty_text)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+static void decode_pty_cobs(benchmark::State& state)
+{
+  decode_pty(state, Protocols::Framing::COBS);
+}
+BENCHMARK(decode_pty_cobs)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();